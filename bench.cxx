@@ -0,0 +1,281 @@
+#include <cstdint>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "src/main.hxx"
+
+using namespace std;
+
+
+
+
+// BENCH-RECORD
+// ------------
+// Result of one phase (load, build, traverse) of a format on a graph.
+
+struct BenchRecord {
+  string graph, format, phase;
+  size_t order = 0, size = 0;
+  float  time  = 0;     // wall time (ms)
+  long   peakRss = 0;   // peak resident set size (KB)
+  size_t bytes = 0;
+  int    effectiveBits = 0;
+  bool   rejected = false;
+  double edgesPerSecond = 0;
+  double rejectedFraction = 0;
+  vector<size_t> bitsHistogram;     // entries with 0, 1, 2, ... block-bits set
+  vector<size_t> entriesHistogram;  // rows with 0, 1, 2-3, 4-7, ... entries
+};
+
+
+string joinHistogram(const vector<size_t>& x, const char *sep) {
+  string a;
+  for (size_t i=0; i<x.size(); i++)
+    a += (i? sep : "") + to_string(x[i]);
+  return a;
+}
+
+
+// Escape a string field, for JSON (quotes, backslashes, control characters)
+// and CSV (doubled quotes).
+string jsonEscape(const string& x) {
+  string a;
+  for (char c : x) {
+    char b[8];
+    if (c=='"' || c=='\\') { a += '\\'; a += c; }
+    else if ((unsigned char) c < 0x20) { snprintf(b, sizeof(b), "\\u%04x", c); a += b; }
+    else a += c;
+  }
+  return a;
+}
+
+string csvEscape(const string& x) {
+  string a;
+  for (char c : x) {
+    if (c=='"') a += '"';
+    a += c;
+  }
+  return a;
+}
+
+
+void writeJson(FILE *f, const vector<BenchRecord>& rs) {
+  fprintf(f, "[\n");
+  for (size_t i=0; i<rs.size(); i++) {
+    const auto& r = rs[i];
+    fprintf(f, "  {\"graph\": \"%s\", \"format\": \"%s\", \"phase\": \"%s\", ", jsonEscape(r.graph).c_str(), jsonEscape(r.format).c_str(), r.phase.c_str());
+    fprintf(f, "\"order\": %zu, \"size\": %zu, \"time_ms\": %.3f, \"peak_rss_kb\": %ld, ", r.order, r.size, r.time, r.peakRss);
+    fprintf(f, "\"bytes\": %zu, \"bytes_per_edge\": %.4f, \"effective_bits\": %d, ", r.bytes, r.size? double(r.bytes)/r.size : 0.0, r.effectiveBits);
+    fprintf(f, "\"rejected\": %s, \"edges_per_second\": %.4e, \"rejected_fraction\": %.4f, ", r.rejected? "true" : "false", r.edgesPerSecond, r.rejectedFraction);
+    fprintf(f, "\"bits_histogram\": [%s], \"entries_histogram\": [%s]}", joinHistogram(r.bitsHistogram, ", ").c_str(), joinHistogram(r.entriesHistogram, ", ").c_str());
+    fprintf(f, i+1<rs.size()? ",\n" : "\n");
+  }
+  fprintf(f, "]\n");
+}
+
+
+void writeCsv(FILE *f, const vector<BenchRecord>& rs) {
+  fprintf(f, "graph,format,phase,order,size,time_ms,peak_rss_kb,bytes,bytes_per_edge,effective_bits,rejected,edges_per_second,rejected_fraction,bits_histogram,entries_histogram\n");
+  for (const auto& r : rs) {
+    fprintf(f, "\"%s\",\"%s\",%s,%zu,%zu,%.3f,%ld,", csvEscape(r.graph).c_str(), csvEscape(r.format).c_str(), r.phase.c_str(), r.order, r.size, r.time, r.peakRss);
+    fprintf(f, "%zu,%.4f,%d,%d,%.4e,%.4f,", r.bytes, r.size? double(r.bytes)/r.size : 0.0, r.effectiveBits, r.rejected, r.edgesPerSecond, r.rejectedFraction);
+    fprintf(f, "%s,%s\n", joinHistogram(r.bitsHistogram, ";").c_str(), joinHistogram(r.entriesHistogram, ";").c_str());
+  }
+}
+
+
+
+
+// INSTRUMENTATION
+// ---------------
+
+template <class C>
+size_t formatBytes(const C& x) {
+  return x.sourceOffsets.size() * sizeof(x.sourceOffsets[0]) + x.destinationIndices.size() * sizeof(x.destinationIndices[0]);
+}
+
+
+void addLog2Bucket(vector<size_t>& a, size_t n) {
+  size_t b = 0;
+  for (; n; n>>=1) b++;
+  if (a.size()<=b) a.resize(b+1);
+  a[b]++;
+}
+
+template <class C>
+auto entriesHistogram(const C& x) {
+  vector<size_t> a;
+  const auto& vto = x.sourceOffsets;
+  for (int u=0, N=csrOrder(x); u<N; u++)
+    addLog2Bucket(a, vto[u+1] - vto[u]);
+  return a;
+}
+
+// Entries of adaptive CSR are bytes.
+auto entriesHistogram(const AdaptiveCsr& x) {
+  vector<size_t> a;
+  const auto& vto = x.sourceOffsets;
+  for (int u=0, N=csrOrder(x); u<N; u++)
+    addLog2Bucket(a, (vto[u+1]>>2) - (vto[u]>>2));
+  return a;
+}
+
+
+template <class C>
+auto bitsHistogram(const C& x) {
+  return vector<size_t>();
+}
+
+template <class T, class U, int BLK>
+auto bitsHistogram(const HybridCsr<T, U, BLK>& x) {
+  vector<size_t> a(x.blockSize+1);
+  for (U e : x.destinationIndices)
+    a[countBits(hybridCsrEntryBlock(e, x.blockSize))]++;
+  return a;
+}
+
+
+
+
+// RUN-*
+// -----
+
+template <class F>
+void runFormat(vector<BenchRecord>& rs, const BenchRecord& g, const char *name, int E, int repeat, F build) {
+  BenchRecord r = g;
+  r.format = name;
+  r.phase  = "build";
+  r.effectiveBits = E;
+  // Skip formats whose effective bits cannot represent all vertex-ids.
+  r.rejected = E<63 && g.order > (size_t(1)<<E);
+  if (r.rejected) { rs.push_back(r); return; }
+  decltype(build()) x;
+  resetPeakRss();
+  r.time    = measureDuration([&]() { x = build(); });
+  r.peakRss = peakRss();
+  r.bytes   = formatBytes(x);
+  r.bitsHistogram    = bitsHistogram(x);
+  r.entriesHistogram = entriesHistogram(x);
+  rs.push_back(r);
+  // Find traversal (SpMV) time.
+  BenchRecord s = g;
+  s.format = name;
+  s.phase  = "traverse";
+  s.effectiveBits = E;
+  s.bytes  = r.bytes;
+  vector<double> v(g.order, 1.0), a(g.order);
+  resetPeakRss();
+  s.time    = measureDuration([&]() { spmvOmp(a, x, v); }, repeat);
+  s.peakRss = peakRss();
+  s.edgesPerSecond = s.time>0? g.size/(s.time/1000) : 0;
+  rs.push_back(s);
+}
+
+
+template <class O>
+void runFormats(vector<BenchRecord>& rs, const BenchRecord& g, const Coo<int>& y, int repeat) {
+  runFormat(rs, g, "csrRegular32", 32, repeat, [&]() { return csrFromCooOmp(y, uint32_t()); });
+  runFormat(rs, g, "csrRegular64", 64, repeat, [&]() { return csrFromCooOmp(y, uint64_t()); });
+  runFormat(rs, g, "csrHybrid32 [4bit block, 28bit index (30 eff.)]",  30, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint32_t(4)); });
+  runFormat(rs, g, "csrHybrid32 [8bit block, 24bit index (27 eff.)]",  27, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint32_t(8)); });
+  runFormat(rs, g, "csrHybrid32 [16bit block, 16bit index (20 eff.)]", 20, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint32_t(16)); });
+  runFormat(rs, g, "csrHybrid64 [4bit block, 60bit index (62 eff.)]",  62, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint64_t(4)); });
+  runFormat(rs, g, "csrHybrid64 [8bit block, 56bit index (59 eff.)]",  59, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint64_t(8)); });
+  runFormat(rs, g, "csrHybrid64 [16bit block, 48bit index (52 eff.)]", 52, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint64_t(16)); });
+  runFormat(rs, g, "csrHybrid64 [32bit block, 32bit index (37 eff.)]", 37, repeat, [&]() { return hybridCsrFromCooOmp<O>(y, uint64_t(32)); });
+  runFormat(rs, g, "csrAdaptive", 64, repeat, [&]() { return adaptiveCsrFromCooOmp(y); });
+}
+
+
+void runGraph(vector<BenchRecord>& rs, const char *spec, uint64_t seed, int repeat) {
+  BenchRecord g;
+  g.graph  = spec;
+  g.format = "coo";
+  g.phase  = "load";
+  Coo<int> y;
+  long a = 0, b = 0;
+  // Generate (or read) the graph, and remove duplicate edges.
+  resetPeakRss();
+  g.time = measureDuration([&]() {
+    if      (sscanf(spec, "rmat:%ld:%ld", &a, &b)==2) y = generateRmatOmp(a, b, seed);
+    else if (sscanf(spec, "er:%ld:%ld",   &a, &b)==2) y = generateErdosRenyiOmp(a, b, seed);
+    else if (sscanf(spec, "grid:%ld:%ld", &a, &b)==2) y = generateGridOmp(a, b, 0.9, seed);
+    else y = readMtxCooOmp(spec);
+    cooDeduplicateOmp(y);
+  });
+  g.peakRss = peakRss();
+  g.order = cooOrder(y);
+  g.size  = cooSize(y);
+  g.bytes = 2 * g.size * sizeof(int);
+  rs.push_back(g);
+  fprintf(stderr, "%s: order %zu size %zu\n", spec, g.order, g.size);
+  if (g.order==0) return;
+  // Hybrid offsets are 32-bit, unless there are too many edges.
+  if (g.size > size_t(INT_MAX)) runFormats<size_t>(rs, g, y, repeat);
+  else runFormats<int>(rs, g, y, repeat);
+}
+
+
+// Fraction of graphs each format rejected (by effective bits).
+void runSummary(vector<BenchRecord>& rs) {
+  vector<BenchRecord> as;
+  for (const auto& r : rs) {
+    if (r.phase!="build") continue;
+    auto it = find_if(as.begin(), as.end(), [&](const auto& a) { return a.format==r.format; });
+    if (it==as.end()) {
+      BenchRecord a;
+      a.graph = "*"; a.format = r.format; a.phase = "summary";
+      a.effectiveBits = r.effectiveBits;
+      as.push_back(a); it = as.end()-1;
+    }
+    it->order++;
+    it->rejectedFraction += r.rejected;
+  }
+  for (auto& a : as) {
+    a.rejectedFraction /= a.order;
+    a.order = 0;
+    rs.push_back(a);
+  }
+}
+
+
+
+
+// MAIN
+// ----
+
+const char *BENCH_USAGE =
+  "Usage: %s [--csv] [--output <file>] [--seed <n>] [--repeat <n>] [graph ...]\n"
+  "Graphs: rmat:<scale>:<edge-factor>, er:<order>:<size>, grid:<rows>:<cols>, or <file.mtx>.\n"
+  "Default: rmat:16:16 er:65536:1048576 grid:256:256\n";
+
+int main(int argc, char **argv) {
+  bool csv = false;
+  const char *out = nullptr;
+  uint64_t seed = 42;
+  int repeat = 5;
+  vector<const char*> specs;
+  for (int i=1; i<argc; i++) {
+    const char *a = argv[i];
+    if      (strcmp(a, "--csv")==0) csv = true;
+    else if (strcmp(a, "--output")==0 && i+1<argc) out = argv[++i];
+    else if (strcmp(a, "--seed")==0   && i+1<argc) seed = strtoull(argv[++i], nullptr, 10);
+    else if (strcmp(a, "--repeat")==0 && i+1<argc) repeat = atoi(argv[++i]);
+    else if (a[0]=='-') { fprintf(stderr, BENCH_USAGE, argv[0]); return a[1]=='h'? 0 : 1; }
+    else specs.push_back(a);
+  }
+  if (specs.empty()) specs = {"rmat:16:16", "er:65536:1048576", "grid:256:256"};
+  vector<BenchRecord> rs;
+  for (const char *spec : specs)
+    runGraph(rs, spec, seed, repeat);
+  runSummary(rs);
+  FILE *f = out? fopen(out, "w") : stdout;
+  if (!f) { fprintf(stderr, "Cannot write %s\n", out); return 1; }
+  if (csv) writeCsv(f, rs);
+  else writeJson(f, rs);
+  if (out) fclose(f);
+  return 0;
+}
@@ -1,6 +1,8 @@
 #include <cstdint>
 #include <cstdio>
+#include <random>
 #include <iostream>
+#include <algorithm>
 #include "src/main.hxx"
 
 using namespace std;
@@ -8,65 +10,407 @@ using namespace std;
 
 
 
+void runReadMtxPrint(const char *name, const char *file, float t) {
+  double MB = fileSize(file) / 1e6;
+  printf("[%09.3f ms; %07.1f MB/s] %s\n", t, MB/(t/1000), name);
+}
+
+
+void runReadMtx(const char *file) {
+  // Find parse throughput of parallel loader, to flat edge list.
+  Coo<int> x1;
+  float t1 = measureDuration([&]() { x1 = readMtxCooOmp(file); });
+  runReadMtxPrint("readMtxCooOmp", file, t1);
+
+  // Find parse throughput of parallel loader, to deduplicated flat edge list.
+  Coo<int> x2;
+  float t2 = measureDuration([&]() { x2 = readMtxCooOmp(file, true); });
+  runReadMtxPrint("readMtxCooOmp [dedup]", file, t2);
+
+  // Find parse throughput of parallel loader, to DiGraph.
+  DiGraph<> x3;
+  float t3 = measureDuration([&]() { x3 = readMtxOmp(file); });
+  runReadMtxPrint("readMtxOmp", file, t3);
+}
+
+
+template <class C, class D>
+void runKernelsFor(const char *name, const C& x, const D& xt, const vector<int>& degs, int s, double MB, double M, vector<float>& ts) {
+  int N = csrOrder(x), i = 0, l = 0;
+  bool base = ts.empty();
+  vector<double> r(N, 1.0/N), a(N);
+  auto report = [&](const char *kernel, float t, double E) {
+    if (base) ts.push_back(t);
+    printf("[%09.3f ms; %.3e edges/s; %05.2fx speedup] %s %s\n", t, E/(t/1000), ts[i++]/t, kernel, name);
+  };
+  // Find traversal speed of BFS, SpMV, and PageRank (pull and push).
+  float t1 = measureDuration([&]() { bfs(x, s); }, 5);
+  report("bfs", t1, MB);
+  float t2 = measureDuration([&]() { bfsOmp(x, s); }, 5);
+  report("bfsOmp", t2, MB);
+  float t3 = measureDuration([&]() { spmv(a, x, r); }, 5);
+  report("spmv", t3, M);
+  float t4 = measureDuration([&]() { spmvOmp(a, x, r); }, 5);
+  report("spmvOmp", t4, M);
+  float t5 = measureDuration([&]() { l = pagerankPull(xt, degs).iterations; });
+  report("pagerankPull", t5, M*l);
+  float t6 = measureDuration([&]() { l = pagerankPullOmp(xt, degs).iterations; });
+  report("pagerankPullOmp", t6, M*l);
+  float t7 = measureDuration([&]() { l = pagerankPush(x, degs).iterations; });
+  report("pagerankPush", t7, M*l);
+  float t8 = measureDuration([&]() { l = pagerankPushOmp(x, degs).iterations; });
+  report("pagerankPushOmp", t8, M*l);
+}
+
+
+template <class K>
+void runKernels(const Coo<K>& y) {
+  Coo<K> empty;
+  auto yt = cooTranspose(y);
+  int S = cooOrder(y);
+  if (S==0) return;
+  vector<float> ts;
+
+  // Find source vertex for BFS (highest out-degree), and edges it reaches.
+  auto csr1 = csrFromCooOmp(y, uint32_t()), csrt1 = csrFromCooOmp(yt, uint32_t());
+  vector<int> degs(S);
+  for (int u=0; u<S; u++)
+    degs[u] = csrDegree(csr1, uint32_t(u));
+  int s = maxElement(degs) - degs.begin();
+  auto ds = bfs(csr1, s);
+  double MB = 0, M = cooSize(y);
+  for (int u=0; u<S; u++)
+    if (ds[u]>=0) MB += degs[u];
+
+  // Find traversal speed of regular CSR (32bit is the baseline).
+  runKernelsFor("csrRegular32", csr1, csrt1, degs, s, MB, M, ts);
+  runKernelsFor("csrRegular64", csrFromCooOmp(y, uint64_t()), csrFromCooOmp(yt, uint64_t()), degs, s, MB, M, ts);
+
+  // Find traversal speed of hybrid CSR, with each block size (if vertex-ids fit).
+  auto runHybrid = [&](const char *name, auto blk, long E) {
+    if (S >= E) return;
+    runKernelsFor(name, hybridCsrFromCooOmp(y, blk), hybridCsrFromCooOmp(yt, blk), degs, s, MB, M, ts);
+  };
+  runHybrid("csrHybrid32 [4bit block, 28bit index (30 eff.)]",  uint32_t(4),  1L<<30);
+  runHybrid("csrHybrid32 [8bit block, 24bit index (27 eff.)]",  uint32_t(8),  1L<<27);
+  runHybrid("csrHybrid32 [16bit block, 16bit index (20 eff.)]", uint32_t(16), 1L<<20);
+  runHybrid("csrHybrid64 [4bit block, 60bit index (62 eff.)]",  uint64_t(4),  1L<<62);
+  runHybrid("csrHybrid64 [8bit block, 56bit index (59 eff.)]",  uint64_t(8),  1L<<59);
+  runHybrid("csrHybrid64 [16bit block, 48bit index (52 eff.)]", uint64_t(16), 1L<<52);
+  runHybrid("csrHybrid64 [32bit block, 32bit index (37 eff.)]", uint64_t(32), 1L<<37);
+
+  // Find traversal speed of adaptive CSR.
+  runKernelsFor("csrAdaptive", adaptiveCsrFromCooOmp(y), adaptiveCsrFromCooOmp(yt), degs, s, MB, M, ts);
+}
+
+
+template <int BLK, class K, class L>
+void runHybridBlockFor(const char *name, const Coo<K>& y, L typ) {
+  int N = cooOrder(y);
+  vector<double> r(N, 1.0/N), a(N);
+  HybridCsr<int, L> x1;
+  HybridCsr<int, L, BLK> x2;
+  // Runtime block size is dispatched once to the same compile-time builder,
+  // so build times should match; SpMV differs by a switch per row. This
+  // compares runtime dispatch against a fixed block size, not the older
+  // (per-entry runtime shift) code.
+  float t1 = measureDuration([&]() { x1 = hybridCsrFromCooOmp(y, L(BLK)); });
+  float t2 = measureDuration([&]() { spmv(a, x1, r); }, 5);
+  printf("[%09.3f ms build; %09.3f ms spmv] %s {runtime block; dispatch per row}\n", t1, t2, name);
+  // Find construction and iteration (SpMV) time, with compile-time block size.
+  float t3 = measureDuration([&]() { x2 = hybridCsrFromCooOmp<BLK>(y, L()); });
+  float t4 = measureDuration([&]() { spmv(a, x2, r); }, 5);
+  printf("[%09.3f ms build; %09.3f ms spmv] %s {compile-time block}\n", t3, t4, name);
+}
+
+
+template <class K>
+void runHybridBlock(const Coo<K>& y) {
+  int S = cooOrder(y);
+  if (S==0) return;
+  if (S < (1L<<30)) runHybridBlockFor<4> ("csrHybrid32 [4bit block, 28bit index (30 eff.)]",  y, uint32_t());
+  if (S < (1L<<27)) runHybridBlockFor<8> ("csrHybrid32 [8bit block, 24bit index (27 eff.)]",  y, uint32_t());
+  if (S < (1L<<20)) runHybridBlockFor<16>("csrHybrid32 [16bit block, 16bit index (20 eff.)]", y, uint32_t());
+  if (S < (1L<<62)) runHybridBlockFor<4> ("csrHybrid64 [4bit block, 60bit index (62 eff.)]",  y, uint64_t());
+  if (S < (1L<<59)) runHybridBlockFor<8> ("csrHybrid64 [8bit block, 56bit index (59 eff.)]",  y, uint64_t());
+  if (S < (1L<<52)) runHybridBlockFor<16>("csrHybrid64 [16bit block, 48bit index (52 eff.)]", y, uint64_t());
+  if (S < (1L<<37)) runHybridBlockFor<32>("csrHybrid64 [32bit block, 32bit index (37 eff.)]", y, uint64_t());
+}
+
+
+template <class C>
+void runHasEdgeFor(const char *name, const C& x, const vector<int>& us, const vector<int>& vs, float t0) {
+  using U = decay_t<decltype(x.destinationIndices[0])>;
+  const char *levels[] = {"scalar", "avx2", "avx512"};
+  int Q = us.size(), L = simdLevel;
+  // Find query rate with each usable SIMD level.
+  for (int l=0; l<=L; l++) {
+    int n = 0;
+    simdLevel = l;
+    float t = measureDuration([&]() {
+      for (int i=0; i<Q; i++)
+        n += csrHasEdge(x, us[i], U(vs[i]));
+    });
+    printf("[%09.3f ms; %.3e queries/s; %05.2fx speedup; %d found] csrHasEdge %s {%s}\n", t, Q/(t/1000), t0/t, n, name, levels[l]);
+  }
+  simdLevel = L;
+}
+
+
+template <class K>
+void runHasEdge(const Coo<K>& y) {
+  const int Q = 1000000;
+  int S = cooOrder(y);
+  size_t M = cooSize(y);
+  if (S==0 || M==0) return;
+  mt19937 rnd(42);
+  vector<int> us(Q), vs(Q);
+  // Half of the queries are existing edges, the rest are random.
+  for (int i=0; i<Q; i++) {
+    size_t j = rnd() % M;
+    us[i] = i%2? y.sources[j] : rnd() % S;
+    vs[i] = i%2? y.targets[j] : rnd() % S;
+  }
+
+  // Find query rate of regular CSR with std::binary_search (baseline).
+  auto csr1 = csrFromCooOmp(y, uint32_t());
+  const auto& vto = csr1.sourceOffsets;
+  const auto& eto = csr1.destinationIndices;
+  int n = 0;
+  float t0 = measureDuration([&]() {
+    for (int i=0; i<Q; i++)
+      n += binary_search(eto.begin()+vto[us[i]], eto.begin()+vto[us[i]+1], uint32_t(vs[i]));
+  });
+  printf("[%09.3f ms; %.3e queries/s; %05.2fx speedup; %d found] std::binary_search csrRegular32\n", t0, Q/(t0/1000), 1.0f, n);
+  runHasEdgeFor("csrRegular32", csr1, us, vs, t0);
+  runHasEdgeFor("csrRegular64", csrFromCooOmp(y, uint64_t()), us, vs, t0);
+
+  // Find query rate of hybrid CSR, with each block size (if vertex-ids fit).
+  if (S < (1L<<30)) runHasEdgeFor("csrHybrid32 [4bit block, 28bit index (30 eff.)]",  hybridCsrFromCooOmp(y, uint32_t(4)),  us, vs, t0);
+  if (S < (1L<<27)) runHasEdgeFor("csrHybrid32 [8bit block, 24bit index (27 eff.)]",  hybridCsrFromCooOmp(y, uint32_t(8)),  us, vs, t0);
+  if (S < (1L<<20)) runHasEdgeFor("csrHybrid32 [16bit block, 16bit index (20 eff.)]", hybridCsrFromCooOmp(y, uint32_t(16)), us, vs, t0);
+  if (S < (1L<<62)) runHasEdgeFor("csrHybrid64 [4bit block, 60bit index (62 eff.)]",  hybridCsrFromCooOmp(y, uint64_t(4)),  us, vs, t0);
+  if (S < (1L<<59)) runHasEdgeFor("csrHybrid64 [8bit block, 56bit index (59 eff.)]",  hybridCsrFromCooOmp(y, uint64_t(8)),  us, vs, t0);
+  if (S < (1L<<52)) runHasEdgeFor("csrHybrid64 [16bit block, 48bit index (52 eff.)]", hybridCsrFromCooOmp(y, uint64_t(16)), us, vs, t0);
+  if (S < (1L<<37)) runHasEdgeFor("csrHybrid64 [32bit block, 32bit index (37 eff.)]", hybridCsrFromCooOmp(y, uint64_t(32)), us, vs, t0);
+}
+
+
 template <class C>
-void runCsrPrint(const char *name, const C& csr) {
+void runCsrPrint(const char *name, const C& csr, const char *order, float tr) {
   using T = decltype(csr.sourceOffsets[0]);
   using U = decltype(csr.destinationIndices[0]);
   const auto& vto = csr.sourceOffsets;
   const auto& eto = csr.destinationIndices;
   size_t so = vto.size(), di = eto.size(), sz = so*sizeof(T) + di*sizeof(U);
-  printf("[%zu bytes %zu source-offsets %zu destination-indices] %s\n", sz, so, di, name);
+  // Find average set bits per entry, and traversal (SpMV) speed.
+  int N = csrOrder(csr);
+  double M = csrSize(csr), bits = di? M/di : 0;
+  vector<double> r(N, 1.0), a(N);
+  float t = measureDuration([&]() { spmv(a, csr, r); }, 5);
+  printf("[%zu bytes %zu source-offsets %zu destination-indices] %s {%s: %.2f bits/entry; %09.3f ms reorder; %.3e edges/s}\n", sz, so, di, name, order, bits, tr, t>0? M/(t/1000) : 0);
+}
+
+
+void runBuildPrint(const char *name, int threads, float t) {
+  printf("[%09.3f ms; %03d threads] %s\n", t, threads, name);
+}
+
+
+template <class G, class K>
+void runBuild(const G& x, const Coo<K>& y) {
+  int T = maxThreads(), S = x.span();
+  G none; Coo<K> empty;
+
+  // Find build time of serial builders, from DiGraph.
+  float t1 = measureDuration([&]() { csr(x, uint32_t()); });
+  runBuildPrint("csrRegular32", 1, t1);
+  float t2 = measureDuration([&]() { hybridCsr(S < (1L<<27)? x:none, uint32_t(8)); });
+  runBuildPrint("csrHybrid32 [8bit block, 24bit index (27 eff.)]", 1, t2);
+  float t3 = measureDuration([&]() { hybridCsr(S < (1L<<37)? x:none, uint64_t(32)); });
+  runBuildPrint("csrHybrid64 [32bit block, 32bit index (37 eff.)]", 1, t3);
+
+  // Find build time of parallel builders, from flat edge list, with 1 to T threads.
+  for (int t=1;; t=min(2*t, T)) {
+    float t4 = measureDuration([&]() { csrFromCooOmp(y, uint32_t(), t); });
+    runBuildPrint("csrFromCooOmp32", t, t4);
+    float t5 = measureDuration([&]() { hybridCsrFromCooOmp(S < (1L<<27)? y:empty, uint32_t(8), t); });
+    runBuildPrint("hybridCsrFromCooOmp32 [8bit block, 24bit index (27 eff.)]", t, t5);
+    float t6 = measureDuration([&]() { hybridCsrFromCooOmp(S < (1L<<37)? y:empty, uint64_t(32), t); });
+    runBuildPrint("hybridCsrFromCooOmp64 [32bit block, 32bit index (37 eff.)]", t, t6);
+    if (t==T) break;
+  }
 }
 
 
 template <class G>
-void runCsr(const G& x) {
-  G empty;
+void runCsr(const G& x, const vector<int>& ks, const char *order, float tr) {
+  vector<int> none;
   int S = x.span();
 
   // Find space usage of 32bit regular CSR.
-  auto csr1 = csr(x, uint32_t());
-  runCsrPrint("csrRegular32", csr1);
+  auto csr1 = csr(x, ks, uint32_t());
+  runCsrPrint("csrRegular32", csr1, order, tr);
 
   // Find space usage of 64bit regular CSR.
-  auto csr2 = csr(x, uint64_t());
-  runCsrPrint("csrRegular64", csr2);
+  auto csr2 = csr(x, ks, uint64_t());
+  runCsrPrint("csrRegular64", csr2, order, tr);
 
   // Find space usage of 32bit hybrid CSR with 4bit block, 28bit index (30 eff.).
-  auto csr3 = hybridCsr(S < (1L<<30)? x:empty, uint32_t(4));
-  runCsrPrint("csrHybrid32 [4bit block, 28bit index (30 eff.)]", csr3);
+  auto csr3 = hybridCsr(x, S < (1L<<30)? ks:none, uint32_t(4));
+  runCsrPrint("csrHybrid32 [4bit block, 28bit index (30 eff.)]", csr3, order, tr);
 
   // Find space usage of 32bit hybrid CSR with 8bit block, 24bit index (27 eff.).
-  auto csr4 = hybridCsr(S < (1L<<27)? x:empty, uint32_t(8));
-  runCsrPrint("csrHybrid32 [8bit block, 24bit index (27 eff.)]", csr4);
+  auto csr4 = hybridCsr(x, S < (1L<<27)? ks:none, uint32_t(8));
+  runCsrPrint("csrHybrid32 [8bit block, 24bit index (27 eff.)]", csr4, order, tr);
 
   // Find space usage of 32bit hybrid CSR with 16bit block, 16bit index (20 eff.).
-  auto csr5 = hybridCsr(S < (1L<<20)? x:empty, uint32_t(16));
-  runCsrPrint("csrHybrid32 [16bit block, 16bit index (20 eff.)]", csr5);
+  auto csr5 = hybridCsr(x, S < (1L<<20)? ks:none, uint32_t(16));
+  runCsrPrint("csrHybrid32 [16bit block, 16bit index (20 eff.)]", csr5, order, tr);
 
   // Find space usage of 64bit hybrid CSR with 4bit block, 60bit index (62 eff.).
-  auto csr6 = hybridCsr(S < (1L<<62)? x:empty, uint64_t(4));
-  runCsrPrint("csrHybrid64 [4bit block, 60bit index (62 eff.)]", csr6);
+  auto csr6 = hybridCsr(x, S < (1L<<62)? ks:none, uint64_t(4));
+  runCsrPrint("csrHybrid64 [4bit block, 60bit index (62 eff.)]", csr6, order, tr);
 
   // Find space usage of 64bit hybrid CSR with 8bit block, 56bit index (59 eff.).
-  auto csr7 = hybridCsr(S < (1L<<59)? x:empty, uint64_t(8));
-  runCsrPrint("csrHybrid64 [8bit block, 56bit index (59 eff.)]", csr7);
+  auto csr7 = hybridCsr(x, S < (1L<<59)? ks:none, uint64_t(8));
+  runCsrPrint("csrHybrid64 [8bit block, 56bit index (59 eff.)]", csr7, order, tr);
 
   // Find space usage of 64bit hybrid CSR with 16bit block, 48bit index (52 eff.).
-  auto csr8 = hybridCsr(S < (1L<<52)? x:empty, uint64_t(16));
-  runCsrPrint("csrHybrid64 [16bit block, 48bit index (52 eff.)]", csr8);
+  auto csr8 = hybridCsr(x, S < (1L<<52)? ks:none, uint64_t(16));
+  runCsrPrint("csrHybrid64 [16bit block, 48bit index (52 eff.)]", csr8, order, tr);
 
   // Find space usage of 64bit hybrid CSR with 32bit block, 32bit index (37 eff.).
-  auto csr9 = hybridCsr(S < (1L<<37)? x:empty, uint64_t(32));
-  runCsrPrint("csrHybrid64 [32bit block, 32bit index (37 eff.)]", csr9);
+  auto csr9 = hybridCsr(x, S < (1L<<37)? ks:none, uint64_t(32));
+  runCsrPrint("csrHybrid64 [32bit block, 32bit index (37 eff.)]", csr9, order, tr);
+
+  // Find space usage of adaptive CSR, with encoding chosen per row (any vertex-id).
+  // Its destination-indices are bytes, so bits/entry is edges per byte.
+  auto csr10 = adaptiveCsr(x, ks);
+  runCsrPrint("csrAdaptive", csr10, order, tr);
+  int ns[3] = {};
+  for (int u=0, N=csrOrder(csr10); u<N; u++)
+    ns[adaptiveCsrEncoding(csr10, u)]++;
+  printf("[%d varint rows %d block rows %d bitmap rows] csrAdaptive {%s}\n", ns[0], ns[1], ns[2], order);
+}
+
+
+template <class G>
+void runCsr(const G& x) {
+  vector<int> ks;
+  auto run = [&](const char *order, auto fn) {
+    float tr = measureDuration([&]() { ks = fn(); });
+    runCsr(x, ks, order, tr);
+  };
+  // Find space usage with each vertex ordering.
+  run("default",    [&]() { return vertices(x); });
+  run("degree",     [&]() { return degreeOrder(x); });
+  run("rcm",        [&]() { return rcmOrder(x); });
+  run("bfs",        [&]() { return bfsOrder(x); });
+  run("dfs",        [&]() { return dfsOrder(x); });
+  run("hubCluster", [&]() { return hubClusterOrder(x); });
+  run("community",  [&]() { return communityOrderOmp(x); });
+}
+
+
+template <class K>
+void runDynamic(const Coo<K>& y) {
+  int S = cooOrder(y);
+  if (S==0 || S >= (1L<<27)) return;
+  auto x0 = dynamicHybridCsrFromCooOmp<8>(y, uint32_t());
+  mt19937 rnd(42);
+  // Find update rate of batches of random edges, against a full rebuild.
+  for (long B=1000; B<=10000000; B*=10) {
+    Coo<K> b, z = y;
+    b.order = S;
+    for (long i=0; i<B; i++) {
+      b.sources.push_back(rnd() % S);
+      b.targets.push_back(rnd() % S);
+    }
+    cooDeduplicateOmp(b);
+    z.sources.insert(z.sources.end(), b.sources.begin(), b.sources.end());
+    z.targets.insert(z.targets.end(), b.targets.begin(), b.targets.end());
+    auto x = x0;
+    float t0 = measureDuration([&]() { hybridCsrFromCooOmp<8>(z, uint32_t()); });
+    float t1 = measureDuration([&]() { dynamicHybridCsrInsertOmp(x, b); });
+    float t2 = measureDuration([&]() { dynamicHybridCsrRemoveOmp(x, b); });
+    // Rate is of distinct edges in batch (after deduplication).
+    size_t M = cooSize(b);
+    auto print = [&](float t, const char *name, const char *op) {
+      printf("[%09.3f ms; %.3e edges/s; %05.2fx speedup] %s [8bit block, 24bit index (27 eff.)] {batch: %zu; %s}\n", t, t>0? M/(t/1000) : 0, t>0? t0/t : 0, name, M, op);
+    };
+    print(t0, "hybridCsrFromCooOmp32", "rebuild");
+    print(t1, "dynamicHybridCsrInsertOmp32", "insert");
+    print(t2, "dynamicHybridCsrRemoveOmp32", "remove");
+    if (M==size_t(S)*S) break;  // larger batches cannot add more edges
+  }
+}
+
+
+void runCsrFilePrint(const char *name, const char *start, const char *from, float tl, float tt) {
+  printf("[%09.3f ms load; %09.3f ms first spmv; %09.3f ms total] %s {%s start; %s}\n", tl, tt, tl+tt, name, start, from);
+}
+
+
+template <class V, class F>
+void runCsrFileFor(const char *name, const char *file, const char *pth, F build) {
+  V x2;
+  if (!writeCsrFile(pth, build(readMtx(file)))) return;
+  // Cold start has files dropped from page cache, warm start has them cached.
+  for (int warm=0; warm<2; warm++) {
+    const char *start = warm? "warm" : "cold";
+    if (!warm) { dropFileCache(file); dropFileCache(pth); }
+    // Find time to load with readMtx, and convert to CSR.
+    decltype(build(readMtx(file))) x1;
+    float t1 = measureDuration([&]() { x1 = build(readMtx(file)); });
+    int N = csrOrder(x1);
+    vector<double> r(N, 1.0), a(N);
+    float t2 = measureDuration([&]() { spmv(a, x1, r); });
+    runCsrFilePrint(name, start, "readMtx", t1, t2);
+    // Find time to map binary file (pages are loaded on first traversal).
+    bool ok = false;
+    float t3 = measureDuration([&]() { ok = readCsrFileView(x2, pth); });
+    if (!ok) continue;
+    float t4 = measureDuration([&]() { spmv(a, x2, r); });
+    runCsrFilePrint(name, start, "readCsrFileView", t3, t4);
+    closeCsrFileView(x2);
+  }
+}
+
+
+void runCsrFile(const char *file, int S) {
+  char pth[] = "/tmp/csrFileXXXXXX";
+  int fd = mkstemp(pth);
+  if (fd<0) return;
+  close(fd);
+  // Compare start up from text file (readMtx + csr/hybridCsr) against binary file.
+  // Hybrid files use 64-bit offsets, so that they hold graphs of any size.
+  runCsrFileFor<CsrView<uint32_t>>("csrRegular32", file, pth,
+    [](const auto& x) { return csr(x, uint32_t()); });
+  if (S < (1L<<27)) runCsrFileFor<HybridCsrView<size_t, uint32_t>>("csrHybrid32 [8bit block, 24bit index (27 eff.)]", file, pth,
+    [](const auto& x) { return hybridCsr<size_t>(x, uint32_t(8)); });
+  if (S < (1L<<37)) runCsrFileFor<HybridCsrView<size_t, uint64_t>>("csrHybrid64 [32bit block, 32bit index (37 eff.)]", file, pth,
+    [](const auto& x) { return hybridCsr<size_t>(x, uint64_t(32)); });
+  unlink(pth);
 }
 
 
 int main(int argc, char **argv) {
   char *file = argv[1];
   printf("Loading graph %s ...\n", file);
-  auto x = readMtx(file); println(x);
+  DiGraph<> x;
+  float t = measureDuration([&]() { x = readMtx(file); });
+  println(x);
+  runReadMtxPrint("readMtx", file, t);
+  runReadMtx(file);
+  auto y = readMtxCooOmp(file, true);
+  runBuild(x, y);
   runCsr(x);
+  runKernels(y);
+  runHybridBlock(y);
+  runHasEdge(y);
+  runDynamic(y);
+  runCsrFile(file, cooOrder(y));
   printf("\n");
   return 0;
 }
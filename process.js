@@ -4,7 +4,7 @@ const path = require('path');
 
 const RGRAPH = /^Loading graph .*\/(.+?)\.mtx \.\.\./m;
 const RORDER = /^order: (\d+) size: (\d+) \{\}$/m;
-const RRESLT = /^\[(\d+) bytes (\d+) source-offsets (\d+) destination-indices\] (\w+)(?: \[(\d+)bit block, (\d+)bit index \((\d+) eff\.\)\])?/m;
+const RRESLT = /^\[(\d+) bytes (\d+) source-offsets (\d+) destination-indices\] (\w+)(?: \[(\d+)bit block, (\d+)bit index \((\d+) eff\.\)\])?(?: \{(\w+): ([\d\.]+) bits\/entry; ([\d\.]+) ms reorder; ([\d\.e+\-]+) edges\/s\})?/m;
 
 
 
@@ -54,7 +54,7 @@ function readLogLine(ln, data, state) {
     state.size  = parseFloat(size);
   }
   else if (RRESLT.test(ln)) {
-    var [, bytes, source_offsets, destination_indices, technique, block_bits, index_bits, effective_bits] = RRESLT.exec(ln);
+    var [, bytes, source_offsets, destination_indices, technique, block_bits, index_bits, effective_bits, ordering, bits_per_entry, reorder_time, edges_per_second] = RRESLT.exec(ln);
     data.get(state.graph).push(Object.assign({}, state, {
       bytes:               parseFloat(bytes),
       source_offsets:      parseFloat(source_offsets),
@@ -62,6 +62,10 @@ function readLogLine(ln, data, state) {
       block_bits:          parseFloat(block_bits||'0'),
       index_bits:          parseFloat(index_bits||'0'),
       effective_bits:      parseFloat(effective_bits||'0'),
+      ordering:            ordering||'default',
+      bits_per_entry:      parseFloat(bits_per_entry||'0'),
+      reorder_time:        parseFloat(reorder_time||'0'),
+      edges_per_second:    parseFloat(edges_per_second||'0'),
       technique:           technique+(block_bits? `-${block_bits}block`:'')
     }));
   }
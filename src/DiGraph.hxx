@@ -77,6 +77,15 @@ class DiGraph {
     M++;
   }
 
+  // Skips the duplicate check; caller ensures the edge is new.
+  void addEdgeUnchecked(int u, int v, E d=E()) {
+    addVertex(u);
+    addVertex(v);
+    vto[u].push_back(v);
+    edata[u].push_back(d);
+    M++;
+  }
+
   void removeEdge(int u, int v) {
     if (!hasEdge(u, v)) return;
     int o = ei(u, v);
@@ -100,6 +100,24 @@ int lowerBoundEqIndex(const J& x, const T& v, F fc) {
 }
 
 
+// Halves the range with a conditional move, instead of a branch.
+template <class T, class V, class F>
+const T* lowerBoundBranchless(const T *ib, size_t N, const V& v, F fc) {
+  if (N==0) return ib;
+  while (N>1) {
+    size_t H = N/2;
+    ib = fc(ib[H], v)? ib+H : ib;
+    N -= H;
+  }
+  return ib + fc(*ib, v);
+}
+
+template <class T>
+const T* lowerBoundBranchless(const T *ib, size_t N, const T& v) {
+  return lowerBoundBranchless(ib, N, v, [](const T& a, const T& b) { return a < b; });
+}
+
+
 
 
 // COUNT
@@ -11,12 +11,12 @@ using std::uint64_t;
 // ---------
 
 template <class T>
-T oneBits(T n) {
+constexpr T oneBits(T n) {
   return (T(1)<<n)-T(1);
 }
 
 template <class T>
-T zeroBits(T n) {
+constexpr T zeroBits(T n) {
   return T(-1)<<n;
 }
 
@@ -26,15 +26,51 @@ T zeroBits(T n) {
 // COUNT
 // -----
 
-int countBits(uint32_t x) {
+// Use POPCNT only when the target has it (else GCC emits a libgcc call).
+#ifdef __POPCNT__
+constexpr int countBits(uint32_t x) {
+  return __builtin_popcount(x);
+}
+
+constexpr int countBits(uint64_t x) {
+  return __builtin_popcountll(x);
+}
+#else
+constexpr int countBits(uint32_t x) {
   x = x - ((x>>1) & 0x55555555U);
   x = (x & 0x33333333U) + ((x>>2) & 0x33333333U);
   return ((x + (x>>4) & 0x0F0F0F0FU) * 0x01010101U)>>24;
 }
 
-int countBits(uint64_t x) {
+constexpr int countBits(uint64_t x) {
   x = x - ((x>>1) & 0x5555555555555555UL);
   x = (x & 0x3333333333333333UL) + ((x>>2) & 0x3333333333333333UL);
   x = ((x + (x>>4) & 0x0F0F0F0F0F0F0F0FUL) * 0x0101010101010101UL)>>56;
   return (int) x;
 }
+#endif
+
+
+
+
+// COUNT-TRAILING-ZEROS (TZCNT)
+// ----------------------------
+
+constexpr int countTrailingZeros(uint32_t x) {
+  return __builtin_ctz(x);
+}
+
+constexpr int countTrailingZeros(uint64_t x) {
+  return __builtin_ctzll(x);
+}
+
+
+
+
+// CLEAR-LOWEST (BLSR)
+// -------------------
+
+template <class T>
+constexpr T clearLowestBit(T x) {
+  return x & (x-T(1));
+}
@@ -6,6 +6,10 @@
 #include <fstream>
 #include <iostream>
 #include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using std::pair;
 using std::string;
@@ -15,6 +19,7 @@ using std::ostream;
 using std::ifstream;
 using std::is_fundamental;
 using std::cout;
+using std::make_pair;
 
 
 
@@ -34,6 +39,48 @@ string readFile(const char *pth) {
 
 
 
+// MAP-FILE
+// --------
+// Map a file read-only into memory (data, size).
+
+size_t fileSize(const char *pth) {
+  struct stat sb;
+  return stat(pth, &sb)==0? sb.st_size : 0;
+}
+
+
+auto mapFileRead(const char *pth) {
+  const char *p = nullptr;
+  int fd = open(pth, O_RDONLY);
+  if (fd<0) return make_pair(p, size_t());
+  struct stat sb;
+  size_t N = fstat(fd, &sb)==0? sb.st_size : 0;
+  void *q = N>0? mmap(nullptr, N, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (q==MAP_FAILED) return make_pair(p, size_t());
+  madvise(q, N, MADV_WILLNEED);
+  return make_pair((const char*) q, N);
+}
+
+
+void unmapFile(pair<const char*, size_t> x) {
+  if (x.first) munmap((void*) x.first, x.second);
+}
+
+
+// Evict (clean) pages of a file from page cache, for cold start measurement.
+bool dropFileCache(const char *pth) {
+  int fd = open(pth, O_RDONLY);
+  if (fd<0) return false;
+  fdatasync(fd);
+  bool a = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED)==0;
+  close(fd);
+  return a;
+}
+
+
+
+
 // WRITE
 // -----
 
@@ -5,5 +5,6 @@
 #include "_ctypes.hxx"
 #include "_iostream.hxx"
 #include "_iterator.hxx"
+#include "_openmp.hxx"
 #include "_utility.hxx"
 #include "_vector.hxx"
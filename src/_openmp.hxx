@@ -0,0 +1,18 @@
+#pragma once
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+
+
+// THREADS
+// -------
+
+int maxThreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 using std::chrono::microseconds;
 using std::chrono::high_resolution_clock;
@@ -42,3 +45,31 @@ bool retry(F fn, int N=2) {
     if (fn()) return true;
   return false;
 }
+
+
+
+
+// PEAK-RSS
+// --------
+// Peak resident set size of this process (KB), from /proc/self/status.
+// Writing 5 to /proc/self/clear_refs resets it (Linux 4.0+), so that peak
+// of each phase can be measured.
+
+long peakRss() {
+  long a = 0;
+  char ln[256];
+  FILE *f = fopen("/proc/self/status", "r");
+  if (!f) return 0;
+  while (fgets(ln, sizeof(ln), f))
+    if (strncmp(ln, "VmHWM:", 6)==0) { a = atol(ln+6); break; }
+  fclose(f);
+  return a;
+}
+
+
+bool resetPeakRss() {
+  FILE *f = fopen("/proc/self/clear_refs", "w");
+  if (!f) return false;
+  bool a = fputs("5", f)>=0;
+  return fclose(f)==0 && a;
+}
@@ -2,11 +2,14 @@
 #include <cmath>
 #include <vector>
 #include <algorithm>
+#include "_cmath.hxx"
+#include "_openmp.hxx"
 
 using std::vector;
 using std::copy;
 using std::swap;
 using std::abs;
+using std::min;
 using std::max;
 using std::sqrt;
 
@@ -679,3 +682,46 @@ template <class T, class U, class V>
 void multiplyOmp(vector<T>& a, const vector<U>& x, const vector<V>& y, int i, int N) {
   multiplyOmp(a.data()+i, x.data()+i, y.data()+i, N);
 }
+
+
+
+
+// INCLUSIVE-SCAN
+// --------------
+
+template <class T>
+void inclusiveScan(T *a, size_t N) {
+  for (size_t i=1; i<N; i++)
+    a[i] += a[i-1];
+}
+
+template <class T>
+void inclusiveScan(vector<T>& a) {
+  inclusiveScan(a.data(), a.size());
+}
+
+
+template <class T>
+void inclusiveScanOmp(T *a, size_t N, int threads=maxThreads()) {
+  const size_t B = 1 << 16;
+  size_t C = ceilDiv(N, B);
+  if (C<=1 || threads<=1) { inclusiveScan(a, N); return; }
+  vector<T> bs(C);
+  #pragma omp parallel for schedule(static,1) num_threads(threads)
+  for (size_t c=0; c<C; c++) {
+    size_t i = c*B, I = min(i+B, N);
+    inclusiveScan(a+i, I-i);
+    bs[c] = a[I-1];
+  }
+  inclusiveScan(bs.data(), C);
+  #pragma omp parallel for schedule(static,1) num_threads(threads)
+  for (size_t c=1; c<C; c++) {
+    size_t i = c*B, I = min(i+B, N);
+    addValue(a+i, int(I-i), bs[c-1]);
+  }
+}
+
+template <class T>
+void inclusiveScanOmp(vector<T>& a, int threads=maxThreads()) {
+  inclusiveScanOmp(a.data(), a.size(), threads);
+}
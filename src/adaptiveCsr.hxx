@@ -0,0 +1,319 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <ostream>
+#include <iostream>
+#include <algorithm>
+#include "_main.hxx"
+#include "coo.hxx"
+#include "csr.hxx"
+
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::memcpy;
+using std::memset;
+using std::vector;
+using std::ostream;
+using std::cout;
+using std::sort;
+
+
+
+
+// VARINT
+// ------
+// Little-endian base-128 (LEB128) unsigned integers.
+
+int varintBytes(uint64_t v) {
+  int a = 1;
+  for (; v>=0x80; v>>=7) a++;
+  return a;
+}
+
+
+uint8_t* varintWrite(uint8_t *p, uint64_t v) {
+  for (; v>=0x80; v>>=7)
+    *p++ = uint8_t(v) | 0x80;
+  *p++ = uint8_t(v);
+  return p;
+}
+
+
+const uint8_t* varintRead(const uint8_t *p, uint64_t& v) {
+  uint64_t a = 0;
+  for (int s=0;; s+=7) {
+    uint8_t b = *p++;
+    a |= uint64_t(b & 0x7F) << s;
+    if (!(b & 0x80)) break;
+  }
+  v = a;
+  return p;
+}
+
+
+
+
+// ADAPTIVE-CSR
+// ------------
+// Each row picks the smallest of three encodings of its (sorted) edges:
+// - VARINT: gaps between vertex-ids, as varints (sparse rows).
+// - BLOCK:  varint base block-id, then 32bit hybrid entries with 8bit block
+//           and 24bit index relative to the base (rows spanning < 2^27 ids).
+// - BITMAP: varint base word-id, then 64bit bitmap words (dense hub rows).
+// Offsets are 64bit byte offsets into destinationIndices, shifted left by 2,
+// with the row's encoding in the low 2 bits.
+
+const int ADAPTIVE_CSR_VARINT = 0;
+const int ADAPTIVE_CSR_BLOCK  = 1;
+const int ADAPTIVE_CSR_BITMAP = 2;
+const int ADAPTIVE_CSR_BLOCK_BITS = 8;
+
+struct AdaptiveCsr {
+  vector<uint64_t> sourceOffsets;
+  vector<uint8_t>  destinationIndices;
+};
+
+
+
+
+// ADAPTIVE-CSR ROW
+// ----------------
+
+// Bytes needed to encode sorted row vs[0..N) (and the encoding chosen).
+template <class K>
+size_t adaptiveCsrRowBytes(const K *vs, size_t N, int& enc) {
+  const int BLK = ADAPTIVE_CSR_BLOCK_BITS, BLK2 = 3;
+  enc = ADAPTIVE_CSR_VARINT;
+  if (N==0) return 0;
+  uint64_t v0 = vs[0], v1 = vs[N-1];
+  size_t a = 0, nb = 0;
+  for (size_t i=0; i<N; i++) {
+    a += varintBytes(uint64_t(vs[i]) - (i? uint64_t(vs[i-1]) : 0));
+    if (i==0 || (uint64_t(vs[i])>>BLK2) != (uint64_t(vs[i-1])>>BLK2)) nb++;
+  }
+  // Block entries need the row's block-ids to fit in the index-bits.
+  uint64_t b0 = v0>>BLK2, b1 = v1>>BLK2;
+  if (b1-b0 < (uint64_t(1)<<(32-BLK))) {
+    size_t b = varintBytes(b0) + 4*nb;
+    if (b<=a) { a = b; enc = ADAPTIVE_CSR_BLOCK; }
+  }
+  uint64_t w0 = v0>>6, w1 = v1>>6;
+  size_t b = varintBytes(w0) + 8*(w1-w0+1);
+  if (b<=a) { a = b; enc = ADAPTIVE_CSR_BITMAP; }
+  return a;
+}
+
+
+// Encode sorted row vs[0..N) at p, return end.
+template <class K>
+uint8_t* adaptiveCsrRowWrite(uint8_t *p, const K *vs, size_t N, int enc) {
+  const int BLK = ADAPTIVE_CSR_BLOCK_BITS, BLK2 = 3;
+  if (N==0) return p;
+  if (enc==ADAPTIVE_CSR_VARINT) {
+    for (size_t i=0; i<N; i++)
+      p = varintWrite(p, uint64_t(vs[i]) - (i? uint64_t(vs[i-1]) : 0));
+  }
+  else if (enc==ADAPTIVE_CSR_BLOCK) {
+    uint64_t b0 = uint64_t(vs[0])>>BLK2;
+    p = varintWrite(p, b0);
+    uint8_t *q = p-4;
+    uint32_t e = 0;
+    for (size_t i=0; i<N; i++) {
+      uint32_t v = uint32_t(uint64_t(vs[i]) - (b0<<BLK2));
+      if (i==0 || hybridCsrEntryId<BLK>(e)!=hybridCsrValueId<BLK>(v)) {
+        if (i>0) memcpy(q, &e, 4);
+        q += 4; e = hybridCsrValueEntry<BLK>(v);
+      }
+      else e |= hybridCsrValueBlock<BLK>(v);
+    }
+    memcpy(q, &e, 4);
+    p = q+4;
+  }
+  else {
+    uint64_t w0 = uint64_t(vs[0])>>6, w1 = uint64_t(vs[N-1])>>6;
+    p = varintWrite(p, w0);
+    memset(p, 0, 8*(w1-w0+1));
+    for (size_t i=0; i<N; i++) {
+      uint64_t v = vs[i], w = (v>>6) - w0, d;
+      memcpy(&d, p+8*w, 8);
+      d |= uint64_t(1) << (v & 63);
+      memcpy(p+8*w, &d, 8);
+    }
+    p += 8*(w1-w0+1);
+  }
+  return p;
+}
+
+
+// Visit each edge in row bytes [ib, ie), in increasing order.
+template <class F>
+void adaptiveCsrRowForEachEdge(const uint8_t *ib, const uint8_t *ie, int enc, F fn) {
+  const int BLK = ADAPTIVE_CSR_BLOCK_BITS, BLK2 = 3;
+  if (ib==ie) return;
+  uint64_t b;
+  if (enc==ADAPTIVE_CSR_VARINT) {
+    uint64_t v = 0;
+    for (const uint8_t *p=ib; p<ie;) {
+      p = varintRead(p, b);
+      fn(v += b);
+    }
+  }
+  else if (enc==ADAPTIVE_CSR_BLOCK) {
+    const uint8_t *p = varintRead(ib, b);
+    for (; p<ie; p+=4) {
+      uint32_t e; memcpy(&e, p, 4);
+      uint64_t pre = (b + hybridCsrEntryId<BLK>(e)) << BLK2;
+      for (uint32_t dat=hybridCsrEntryBlock<BLK>(e); dat; dat=clearLowestBit(dat))
+        fn(pre | countTrailingZeros(dat));
+    }
+  }
+  else {
+    const uint8_t *p = varintRead(ib, b);
+    for (uint64_t w=b; p<ie; p+=8, w++) {
+      uint64_t dat; memcpy(&dat, p, 8);
+      for (; dat; dat=clearLowestBit(dat))
+        fn((w<<6) | countTrailingZeros(dat));
+    }
+  }
+}
+
+
+
+
+// ADAPTIVE-CSR GRAPH-LIKE
+// -----------------------
+
+int csrOrder(const AdaptiveCsr& x) {
+  return x.sourceOffsets.size()-1;
+}
+
+
+int adaptiveCsrEncoding(const AdaptiveCsr& x, size_t u) {
+  return x.sourceOffsets[u] & 3;
+}
+
+
+template <class F>
+void csrForEachEdge(const AdaptiveCsr& x, size_t u, F fn) {
+  const auto& vto = x.sourceOffsets;
+  const uint8_t *ib = x.destinationIndices.data() + (vto[u]>>2);
+  const uint8_t *ie = x.destinationIndices.data() + (vto[u+1]>>2);
+  adaptiveCsrRowForEachEdge(ib, ie, vto[u] & 3, fn);
+}
+
+
+int csrDegree(const AdaptiveCsr& x, size_t u) {
+  int a = 0;
+  csrForEachEdge(x, u, [&](auto v) { a++; });
+  return a;
+}
+
+
+size_t csrSize(const AdaptiveCsr& x) {
+  size_t a = 0;
+  for (int u=0, N=csrOrder(x); u<N; u++)
+    a += csrDegree(x, u);
+  return a;
+}
+
+
+auto csrVertices(const AdaptiveCsr& x) {
+  return rangeIter(csrOrder(x));
+}
+
+
+
+
+// ADAPTIVE-CSR (FROM GRAPH)
+// -------------------------
+
+template <class G, class J>
+auto adaptiveCsr(const G& x, J&& ks) {
+  AdaptiveCsr a;
+  auto& vto = a.sourceOffsets;
+  auto& eto = a.destinationIndices;
+  auto ids  = indices(ks);
+  vector<uint64_t> vs;
+  for (int u : ks) {
+    vs.clear();
+    for (int v : x.edges(u))
+      vs.push_back(ids[v]);
+    sort(vs.begin(), vs.end());
+    int enc; size_t i = eto.size();
+    eto.resize(i + adaptiveCsrRowBytes(vs.data(), vs.size(), enc));
+    adaptiveCsrRowWrite(eto.data()+i, vs.data(), vs.size(), enc);
+    vto.push_back(i<<2 | enc);
+  }
+  vto.push_back(eto.size()<<2);
+  return a;
+}
+
+template <class G>
+auto adaptiveCsr(const G& x) {
+  return adaptiveCsr(x, x.vertices());
+}
+
+
+
+
+// ADAPTIVE-CSR (FROM EDGE-LIST)
+// -----------------------------
+// Build sorted regular CSR, size each row's encoding, then fill rows.
+
+template <class K>
+void adaptiveCsrFromCooOmp(AdaptiveCsr& a, const Coo<K>& x, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& eto = a.destinationIndices;
+  Csr<size_t, K> y; csrFromCooOmp(y, x, threads);
+  const auto& yto = y.sourceOffsets;
+  const auto& fto = y.destinationIndices;
+  size_t N = cooOrder(x);
+  vector<uint64_t> bs(N+1);
+  vector<uint8_t>  es(N);
+  // Choose encoding of each row, and find its size.
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    int enc;
+    bs[u+1] = adaptiveCsrRowBytes(fto.data()+yto[u], yto[u+1]-yto[u], enc);
+    es[u]   = enc;
+  }
+  inclusiveScanOmp(bs, threads);
+  eto.resize(bs[N]);
+  vto.resize(N+1);
+  // Fill encoded rows.
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    adaptiveCsrRowWrite(eto.data()+bs[u], fto.data()+yto[u], yto[u+1]-yto[u], es[u]);
+    vto[u] = bs[u]<<2 | es[u];
+  }
+  vto[N] = bs[N]<<2;
+}
+
+template <class K>
+auto adaptiveCsrFromCooOmp(const Coo<K>& x, int threads=maxThreads()) {
+  AdaptiveCsr a; adaptiveCsrFromCooOmp(a, x, threads);
+  return a;
+}
+
+
+
+
+// ADAPTIVE-CSR PRINT
+// ------------------
+
+void write(ostream& a, const AdaptiveCsr& x, bool all=false) {
+  a << "order: " << csrOrder(x) << " size: " << csrSize(x);
+  if (!all) { a << " {}"; return; }
+  a << " {\n";
+  for (int u=0, N=csrOrder(x); u<N; u++) {
+    a << "  " << u << " ->";
+    csrForEachEdge(x, u, [&](auto v) { a << " " << v; });
+    a << "\n";
+  }
+  a << "}";
+}
+
+void print(const AdaptiveCsr& x, bool all=false) { write(cout, x, all); }
+void println(const AdaptiveCsr& x, bool all=false) { print(x, all); cout << "\n"; }
@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "_main.hxx"
+#include "csr.hxx"
+
+using std::vector;
+using std::swap;
+
+
+
+
+// BFS
+// ---
+// Find distance of each vertex from source (-1 if unreachable).
+
+template <class C>
+auto bfs(const C& x, int s) {
+  int N = csrOrder(x);
+  vector<int> a(N, -1), q(N);
+  int qb = 0, qe = 0;
+  a[s] = 0; q[qe++] = s;
+  while (qb<qe) {
+    int u = q[qb++];
+    csrForEachEdge(x, u, [&](auto v) {
+      if (a[v]>=0) return;
+      a[v] = a[u]+1;
+      q[qe++] = v;
+    });
+  }
+  return a;
+}
+
+
+
+
+// BFS-OMP
+// -------
+// Level-synchronous, with vertices claimed by compare-and-swap.
+
+template <class C>
+auto bfsOmp(const C& x, int s) {
+  int N = csrOrder(x);
+  vector<int> a(N, -1), f(N), g(N);
+  int nf = 0, ng = 0;
+  a[s] = 0; f[nf++] = s;
+  for (int d=1; nf>0; d++) {
+    ng = 0;
+    #pragma omp parallel for schedule(dynamic,1024)
+    for (int i=0; i<nf; i++) {
+      csrForEachEdge(x, f[i], [&](auto v) {
+        int e = -1;
+        if (__atomic_load_n(&a[v], __ATOMIC_RELAXED)>=0) return;
+        if (!__atomic_compare_exchange_n(&a[v], &e, d, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
+        int j;
+        #pragma omp atomic capture
+        j = ng++;
+        g[j] = v;
+      });
+    }
+    swap(f, g); nf = ng;
+  }
+  return a;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <vector>
+#include <ostream>
+#include <iostream>
+#include <algorithm>
+#include "_main.hxx"
+
+using std::vector;
+using std::ostream;
+using std::cout;
+using std::sort;
+using std::unique;
+
+
+
+
+// COO
+// ---
+// Flat edge list (coordinate format), with 0-based vertex ids.
+
+template <class K=int>
+struct Coo {
+  K order = 0;
+  vector<K> sources;
+  vector<K> targets;
+};
+
+
+
+
+// COO GRAPH-LIKE
+// --------------
+
+template <class K>
+K cooOrder(const Coo<K>& x) {
+  return x.order;
+}
+
+
+template <class K>
+size_t cooSize(const Coo<K>& x) {
+  return x.sources.size();
+}
+
+
+
+
+// COO PRINT
+// ---------
+
+template <class K>
+void write(ostream& a, const Coo<K>& x, bool all=false) {
+  a << "order: " << cooOrder(x) << " size: " << cooSize(x);
+  if (!all) { a << " {}"; return; }
+  a << " {\n";
+  for (size_t i=0, M=cooSize(x); i<M; i++)
+    a << "  " << x.sources[i] << " -> " << x.targets[i] << "\n";
+  a << "}";
+}
+
+template <class K>
+void print(const Coo<K>& x, bool all=false) { write(cout, x, all); }
+
+template <class K>
+void println(const Coo<K>& x, bool all=false) { print(x, all); cout << "\n"; }
+
+
+
+
+// COO-TRANSPOSE
+// -------------
+
+template <class K>
+auto cooTranspose(const Coo<K>& x) {
+  Coo<K> a;
+  a.order   = x.order;
+  a.sources = x.targets;
+  a.targets = x.sources;
+  return a;
+}
+
+
+
+
+// COO-DEDUPLICATE
+// ---------------
+// Remove duplicate edges, leaving edges sorted by source, then target.
+
+template <class K>
+void cooDeduplicateOmp(Coo<K>& a, int threads=maxThreads()) {
+  size_t N = a.order, M = cooSize(a);
+  vector<size_t> offs(N+1);
+  vector<K> vs(M);
+  // Bucket targets by source (counting sort, parallel with atomics).
+  // Atomic updates stall on cache misses, so a single thread avoids them.
+  if (threads>1) {
+    #pragma omp parallel for schedule(static,4096) num_threads(threads)
+    for (size_t i=0; i<M; i++) {
+      #pragma omp atomic
+      offs[a.sources[i]+1]++;
+    }
+  }
+  else {
+    for (size_t i=0; i<M; i++)
+      offs[a.sources[i]+1]++;
+  }
+  inclusiveScanOmp(offs, threads);
+  vector<size_t> ptrs(offs.begin(), offs.end()-1);
+  if (threads>1) {
+    #pragma omp parallel for schedule(static,4096) num_threads(threads)
+    for (size_t i=0; i<M; i++) {
+      size_t j;
+      #pragma omp atomic capture
+      j = ptrs[a.sources[i]]++;
+      vs[j] = a.targets[i];
+    }
+  }
+  else {
+    for (size_t i=0; i<M; i++)
+      vs[ptrs[a.sources[i]]++] = a.targets[i];
+  }
+  // Sort and deduplicate each row.
+  vector<size_t> degs(N+1);
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    auto ib = vs.begin()+offs[u], ie = vs.begin()+offs[u+1];
+    sort(ib, ie);
+    degs[u+1] = unique(ib, ie) - ib;
+  }
+  // Compact rows back into the edge list (at prefix sum of degrees).
+  inclusiveScanOmp(degs, threads);
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    for (size_t i=offs[u], j=degs[u], J=degs[u+1]; j<J; i++, j++) {
+      a.sources[j] = K(u);
+      a.targets[j] = vs[i];
+    }
+  }
+  a.sources.resize(degs[N]);
+  a.targets.resize(degs[N]);
+}
@@ -1,17 +1,27 @@
 #pragma once
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <vector>
 #include <utility>
 #include <ostream>
 #include <iostream>
+#include <algorithm>
+#include <type_traits>
 #include "_main.hxx"
 #include "edges.hxx"
+#include "coo.hxx"
 
 using std::vector;
 using std::ostream;
 using std::cout;
 using std::log;
 using std::move;
+using std::sort;
+using std::integral_constant;
+using std::abort;
+using std::numeric_limits;
 
 
 
@@ -58,14 +68,23 @@ int csrDegree(const Csr<T, U>& x, T u) {
 
 template <class T, class U>
 auto csrVertices(const Csr<T, U>& x) {
-  return range(csrOrder(x));
+  return rangeIter(csrOrder(x));
 }
 
 
 template <class T, class U>
 auto csrEdges(const Csr<T, U>& x, T u) {
   const auto& vto = x.sourceOffsets;
-  return slice(x.destinationIndices, vto[u], vto[u+1]);
+  return sliceIter(x.destinationIndices, vto[u], vto[u+1]);
+}
+
+
+template <class T, class U, class F>
+void csrForEachEdge(const Csr<T, U>& x, size_t u, F fn) {
+  const auto& vto = x.sourceOffsets;
+  const auto& eto = x.destinationIndices;
+  for (T i=vto[u], I=vto[u+1]; i<I; i++)
+    fn(eto[i]);
 }
 
 
@@ -99,6 +118,21 @@ void println(const Csr<T, U>& x, bool all=false) { print(x, all); cout << "\n";
 
 
 
+// CSR-CHECK-OFFSETS
+// -----------------
+// Offsets of type T must hold the number of entries (else they overflow);
+// use 64bit offsets for graphs with more than 2^31 edges.
+
+template <class T>
+void csrCheckOffsets(size_t M, const char *name) {
+  if (M <= size_t(numeric_limits<T>::max())) return;
+  fprintf(stderr, "%s: %zu entries overflow %zu-byte offsets\n", name, M, sizeof(T));
+  abort();
+}
+
+
+
+
 // CSR (FROM GRAPH)
 // ----------------
 
@@ -126,72 +160,184 @@ auto csr(const G& x, K typ) {
 
 
 
+// CSR (FROM EDGE-LIST)
+// --------------------
+// Parallel counting sort of edges by source, then sort of each row.
+
+template <class T, class U, class K>
+void csrFromCooOmp(Csr<T, U>& a, const Coo<K>& x, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& eto = a.destinationIndices;
+  size_t N = cooOrder(x), M = cooSize(x);
+  csrCheckOffsets<T>(M, "csrFromCooOmp");
+  vto.assign(N+1, T());
+  eto.resize(M);
+  // Count degree of each vertex.
+  #pragma omp parallel for schedule(static,4096) num_threads(threads)
+  for (size_t i=0; i<M; i++) {
+    #pragma omp atomic
+    vto[x.sources[i]+1]++;
+  }
+  inclusiveScanOmp(vto, threads);
+  // Scatter targets into their rows.
+  vector<T> ptrs(vto.begin(), vto.end()-1);
+  #pragma omp parallel for schedule(static,4096) num_threads(threads)
+  for (size_t i=0; i<M; i++) {
+    T j;
+    #pragma omp atomic capture
+    j = ptrs[x.sources[i]]++;
+    eto[j] = U(x.targets[i]);
+  }
+  // Sort each row.
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++)
+    sort(eto.begin()+vto[u], eto.begin()+vto[u+1]);
+}
+
+template <class K, class T>
+auto csrFromCooOmp(const Coo<K>& x, T typ, int threads=maxThreads()) {
+  Csr<T> a; csrFromCooOmp(a, x, threads);
+  return a;
+}
+
+
+
+
 // HYBRID-CSR
 // ----------
+// Block size is a compile-time constant (BLK), or given at runtime (BLK=0).
 
-template <class T, class U=T>
-struct HybridCsr : public Csr<T, U> {
+template <class T, class U=T, int BLK=0>
+struct HybridCsr {
+  static constexpr int blockSize = BLK;
+  vector<T> sourceOffsets;
+  vector<U> destinationIndices;
+
+  HybridCsr() = default;
+  HybridCsr(vector<T>&& vto, vector<U>&& eto) :
+  sourceOffsets(move(vto)), destinationIndices(move(eto)) {}
+};
+
+template <class T, class U>
+struct HybridCsr<T, U, 0> {
   int blockSize;
   vector<T> sourceOffsets;
   vector<U> destinationIndices;
 
   HybridCsr(int blk=4) : blockSize(blk) {}
-  HybridCsr(int blk, vector<T>&& vto, vector<T>&& eto) :
-  blockSize(blk), sourceOffsets(vto), destinationIndices(eto) {}
-  HybridCsr(int blk, vector<T>& vto, vector<T>& eto) :
+  HybridCsr(int blk, vector<T>&& vto, vector<U>&& eto) :
   blockSize(blk), sourceOffsets(move(vto)), destinationIndices(move(eto)) {}
 };
 
 
 
 
+// HYBRID-CSR DISPATCH
+// -------------------
+// Call fn with runtime block size as a compile-time constant.
+// Block size is a power of 2, up to 32 (and less than the bits in entry U).
+// Any other block size aborts.
+
+template <class U, class F>
+auto hybridCsrDispatch(int blk, F fn) {
+  switch (blk) {
+    case 1:  return fn(integral_constant<int, 1>());
+    case 2:  return fn(integral_constant<int, 2>());
+    case 4:  return fn(integral_constant<int, 4>());
+    case 8:  return fn(integral_constant<int, 8>());
+    case 16: return fn(integral_constant<int, 16>());
+    case 32: if constexpr (32 < 8*sizeof(U)) return fn(integral_constant<int, 32>());
+    default: abort();
+  }
+}
+
+
+
+
 // HYBRID-CSR HELPERS
 // ------------------
 
 template <class T>
-T hybridCsrEntryId(T e, int blk) {
+constexpr T hybridCsrEntryId(T e, int blk) {
   return e >> blk;
 }
 
 template <class T>
-T hybridCsrEntryBlock(T e, int blk) {
+constexpr T hybridCsrEntryBlock(T e, int blk) {
   return e & oneBits(T(blk));
 }
 
 template <class T>
-T hybridCsrValueId(T v, int blk2) {
+constexpr T hybridCsrValueId(T v, int blk2) {
   return v >> blk2;
 }
 
 template <class T>
-T hybridCsrValueBlock(T v, int blk2) {
-  return 1 << (v & oneBits(T(blk2)));
+constexpr T hybridCsrValueBlock(T v, int blk2) {
+  return T(1) << (v & oneBits(T(blk2)));
 }
 
 template <class T>
-T hybridCsrValueEntry(T v, int blk2) {
+constexpr T hybridCsrValueEntry(T v, int blk2) {
   int blk = 1 << blk2;
   return (hybridCsrValueId(v, blk2) << blk) | hybridCsrValueBlock(v, blk2);
 }
 
 
+template <int BLK, class T>
+constexpr T hybridCsrEntryId(T e) {
+  return hybridCsrEntryId(e, BLK);
+}
+
+template <int BLK, class T>
+constexpr T hybridCsrEntryBlock(T e) {
+  return hybridCsrEntryBlock(e, BLK);
+}
+
+template <int BLK, class T>
+constexpr T hybridCsrValueId(T v) {
+  return hybridCsrValueId(v, countTrailingZeros(uint32_t(BLK)));
+}
+
+template <int BLK, class T>
+constexpr T hybridCsrValueBlock(T v) {
+  return hybridCsrValueBlock(v, countTrailingZeros(uint32_t(BLK)));
+}
+
+template <int BLK, class T>
+constexpr T hybridCsrValueEntry(T v) {
+  return hybridCsrValueEntry(v, countTrailingZeros(uint32_t(BLK)));
+}
+
+
 
 
 // HYBRID-CSR-FIND
 // ---------------
 
-template <class I, class T>
-int hybridCsrFind(I ib, I ie, T v, int blk) {
-  int blk2 = int(log(blk)/log(2)), i = 0;
-  T vid  = hybridCsrValueId(v, blk2);
-  T vblk = hybridCsrValueBlock(v, blk2);
+template <int BLK, class I, class T>
+int hybridCsrFind(I ib, I ie, T v) {
+  T vid  = hybridCsrValueId<BLK>(v);
+  T vblk = hybridCsrValueBlock<BLK>(v);
+  int i = 0;
   for (auto it=ib; it!=ie; ++it, i++) {
-    if (hybridCsrEntryId(*it, blk) != vid) continue;
-    if (hybridCsrEntryBlock(*it, blk) & vblk) return i;
+    if (hybridCsrEntryId<BLK>(*it) != vid) continue;
+    if (hybridCsrEntryBlock<BLK>(*it) & vblk) return i;
   }
   return -1;
 }
 
+template <int BLK, class J, class T>
+int hybridCsrFind(J&& x, T v) {
+  return hybridCsrFind<BLK>(x.begin(), x.end(), v);
+}
+
+
+template <class I, class T>
+int hybridCsrFind(I ib, I ie, T v, int blk) {
+  return hybridCsrDispatch<T>(blk, [&](auto B) { return hybridCsrFind<B()>(ib, ie, v); });
+}
+
 template <class J, class T>
 int hybridCsrFind(J&& x, T v, int blk) {
   return hybridCsrFind(x.begin(), x.end(), v, blk);
@@ -203,29 +349,71 @@ int hybridCsrFind(J&& x, T v, int blk) {
 // HYBRID-CSR-ADD
 // --------------
 
+template <int BLK, class T>
+void hybridCsrPush(vector<T>& a, T v) {
+  a.push_back(hybridCsrValueEntry<BLK>(v));
+}
+
 template <class T>
 void hybridCsrPush(vector<T>& a, T v, int blk) {
-  int blk2 = int(log(blk)/log(2));
-  a.push_back(hybridCsrValueEntry(v, blk2));
+  hybridCsrDispatch<T>(blk, [&](auto B) { hybridCsrPush<B()>(a, v); });
 }
 
 
+// Set block-bit in entry with matching index-bits, or add a new entry.
+template <int BLK, class T>
+void hybridCsrAdd(vector<T>& a, T v) {
+  T vid = hybridCsrValueId<BLK>(v);
+  for (auto& e : a)
+    if (hybridCsrEntryId<BLK>(e)==vid) { e |= hybridCsrValueBlock<BLK>(v); return; }
+  a.push_back(hybridCsrValueEntry<BLK>(v));
+}
+
 template <class T>
 void hybridCsrAdd(vector<T>& a, T v, int blk) {
-  int blk2 = int(log(blk)/log(2));
-  int i = hybridCsrFind(a, v, blk);
-  if (i<0) a.push_back(hybridCsrValueEntry(v, blk2));
-  else a[i] |= hybridCsrValueBlock(v, blk2);
+  hybridCsrDispatch<T>(blk, [&](auto B) { hybridCsrAdd<B()>(a, v); });
 }
 
 
+template <int BLK, class T>
+void hybridCsrSortedAdd(vector<T>& a, T v) {
+  T eid = hybridCsrEntryId<BLK>(a.back());
+  T vid = hybridCsrValueId<BLK>(v);
+  if (eid!=vid) a.push_back(hybridCsrValueEntry<BLK>(v));
+  else a.back() |= hybridCsrValueBlock<BLK>(v);
+}
+
 template <class T>
 void hybridCsrSortedAdd(vector<T>& a, T v, int blk) {
-  int blk2 = int(log(blk)/log(2));
-  T eid = hybridCsrEntryId(a.back(), blk);
-  T vid = hybridCsrValueId(v, blk2);
-  if (eid!=vid) a.push_back(hybridCsrValueEntry(v, blk2));
-  else a.back() |= hybridCsrValueBlock(v, blk2);
+  hybridCsrDispatch<T>(blk, [&](auto B) { hybridCsrSortedAdd<B()>(a, v); });
+}
+
+
+
+
+// HYBRID-CSR ROW
+// --------------
+// Degree of, and edges in, a row of entries [ib, ie).
+
+template <int BLK, class U>
+int hybridCsrRowDegree(const U *ib, const U *ie) {
+  int a = 0;
+  for (auto it=ib; it!=ie; ++it)
+    a += countBits(hybridCsrEntryBlock<BLK>(*it));
+  return a;
+}
+
+
+// Visit each set block-bit, lowest first (tzcnt, blsr).
+template <int BLK, class U, class F>
+void hybridCsrRowForEachEdge(const U *ib, const U *ie, F fn) {
+  const int BLK2 = countTrailingZeros(uint32_t(BLK));
+  for (auto it=ib; it!=ie; ++it) {
+    U pre = hybridCsrEntryId<BLK>(*it) << BLK2;
+    U dat = hybridCsrEntryBlock<BLK>(*it);
+    for (; dat; dat=clearLowestBit(dat))
+      fn(pre | U(countTrailingZeros(dat)));
+  }
 }
 
 
@@ -234,69 +422,161 @@ void hybridCsrSortedAdd(vector<T>& a, T v, int blk) {
 // HYBRID-CSR GRAPH-LIKE
 // ---------------------
 
-template <class T, class U>
-int csrOrder(const HybridCsr<T, U>& x) {
+template <class T, class U, int BLK>
+int csrOrder(const HybridCsr<T, U, BLK>& x) {
   return x.sourceOffsets.size()-1;
 }
 
 
-template <class T, class U>
-int csrDegree(const HybridCsr<T, U>& x, T u) {
+template <class T, class U, int BLK>
+int csrDegree(const HybridCsr<T, U, BLK>& x, T u) {
   const auto& vto = x.sourceOffsets;
-  const auto& eto = x.destinationIndices;
-  int blk = x.blockSize, a = 0;
-  for (T i=vto[u], I=vto[u+1]; i<I; i++)
-    a += countBits(hybridCsrEntryBlock(eto[i], blk));
-  return a;
+  const U *ib = x.destinationIndices.data() + vto[u];
+  const U *ie = x.destinationIndices.data() + vto[u+1];
+  if constexpr (BLK>0) return hybridCsrRowDegree<BLK>(ib, ie);
+  else return hybridCsrDispatch<U>(x.blockSize, [&](auto B) { return hybridCsrRowDegree<B()>(ib, ie); });
 }
 
 
-template <class T, class U>
-int csrSize(const HybridCsr<T, U>& x) {
-  int a = 0;
+template <class T, class U, int BLK>
+size_t csrSize(const HybridCsr<T, U, BLK>& x) {
+  size_t a = 0;
   for (T u=0, N=csrOrder(x); u<N; u++)
     a += csrDegree(x, u);
   return a;
 }
 
 
-template <class T, class U>
-auto csrVertices(const HybridCsr<T, U>& x) {
-  return range(csrOrder(x));
+template <class T, class U, int BLK>
+auto csrVertices(const HybridCsr<T, U, BLK>& x) {
+  return rangeIter(csrOrder(x));
 }
 
 
-// template <class T, class U>
-// auto hybridCsrEdges(const Csr<T, U>& x, T u) {
-// }
+template <class T, class U, int BLK, class F>
+void csrForEachEdge(const HybridCsr<T, U, BLK>& x, size_t u, F fn) {
+  const auto& vto = x.sourceOffsets;
+  const U *ib = x.destinationIndices.data() + vto[u];
+  const U *ie = x.destinationIndices.data() + vto[u+1];
+  if constexpr (BLK>0) hybridCsrRowForEachEdge<BLK>(ib, ie, fn);
+  else hybridCsrDispatch<U>(x.blockSize, [&](auto B) { hybridCsrRowForEachEdge<B()>(ib, ie, fn); });
+}
 
 
 
 
 // HYBRID-CSR (FROM GRAPH)
 // -----------------------
+// Offsets of type O (use 64bit when entries may exceed 2^31).
 
-template <class G, class J, class K>
-auto hybridCsr(const G& x, J&& ks, K blk) {
-  HybridCsr<int, K> a(blk);
+template <int BLK, class O=int, class G, class J, class K>
+auto hybridCsr(const G& x, J&& ks, K typ) {
+  HybridCsr<O, K, BLK> a;
   auto& vto = a.sourceOffsets;
   auto& eto = a.destinationIndices;
   auto ids  = indices(ks);
+  csrCheckOffsets<O>(x.size(), "hybridCsr");
+  vector<int> vs;
   for (int u : ks) {
-    vto.push_back(eto.size());
-    auto vs = edges(x, u, [&](int v) { return ids[v]; });
+    vto.push_back(O(eto.size()));
+    vs.clear();
+    for (int v : x.edges(u))
+      vs.push_back(ids[v]);
     sort(vs.begin(), vs.end());
-    if (!vs.empty()) hybridCsrPush(eto, K(vs[0]), blk);
+    if (!vs.empty()) hybridCsrPush<BLK>(eto, K(vs[0]));
     for (int v : sliceIter(vs, 1))
-      hybridCsrSortedAdd(eto, K(v), blk);
+      hybridCsrSortedAdd<BLK>(eto, K(v));
   }
-  vto.push_back(eto.size());
+  vto.push_back(O(eto.size()));
   return a;
 }
 
-template <class G, class K>
+template <int BLK, class O=int, class G, class K>
+auto hybridCsr(const G& x, K typ) {
+  return hybridCsr<BLK, O>(x, x.vertices(), typ);
+}
+
+
+template <class O=int, class G, class J, class K>
+auto hybridCsr(const G& x, J&& ks, K blk) {
+  HybridCsr<O, K> a(blk);
+  hybridCsrDispatch<K>(blk, [&](auto B) {
+    auto b = hybridCsr<B(), O>(x, ks, K());
+    a.sourceOffsets      = move(b.sourceOffsets);
+    a.destinationIndices = move(b.destinationIndices);
+  });
+  return a;
+}
+
+template <class O=int, class G, class K>
 auto hybridCsr(const G& x, K blk) {
-  return hybridCsr(x, x.vertices(), blk);
+  return hybridCsr<O>(x, x.vertices(), blk);
+}
+
+
+
+
+// HYBRID-CSR (FROM EDGE-LIST)
+// ---------------------------
+// Build sorted regular CSR, count entries per row, then fill entries.
+
+template <class O, class T, int BLK, class K>
+void hybridCsrFromCooOmp(HybridCsr<O, T, BLK>& a, const Coo<K>& x, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& eto = a.destinationIndices;
+  csrCheckOffsets<O>(cooSize(x), "hybridCsrFromCooOmp");
+  Csr<size_t, K> y; csrFromCooOmp(y, x, threads);
+  const auto& yto = y.sourceOffsets;
+  const auto& fto = y.destinationIndices;
+  size_t N = cooOrder(x);
+  vto.assign(N+1, 0);
+  // Count distinct index-bits in each row.
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    int n = 0; T pid = T();
+    for (size_t i=yto[u], I=yto[u+1]; i<I; i++) {
+      T vid = hybridCsrValueId<BLK>(T(fto[i]));
+      if (i==yto[u] || vid!=pid) n++;
+      pid = vid;
+    }
+    vto[u+1] = n;
+  }
+  inclusiveScanOmp(vto, threads);
+  eto.resize(vto[N]);
+  // Fill entries of each row.
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    size_t j = vto[u]; T pid = T();
+    for (size_t i=yto[u], I=yto[u+1]; i<I; i++) {
+      T v = T(fto[i]), vid = hybridCsrValueId<BLK>(v);
+      if (i==yto[u] || vid!=pid) eto[j++] = hybridCsrValueEntry<BLK>(v);
+      else eto[j-1] |= hybridCsrValueBlock<BLK>(v);
+      pid = vid;
+    }
+  }
+}
+
+template <int BLK, class O=int, class K, class T>
+auto hybridCsrFromCooOmp(const Coo<K>& x, T typ, int threads=maxThreads()) {
+  HybridCsr<O, T, BLK> a; hybridCsrFromCooOmp(a, x, threads);
+  return a;
+}
+
+
+// Offsets of type O (use 64bit when entries may exceed 2^31).
+template <class O, class T, class K>
+void hybridCsrFromCooOmp(HybridCsr<O, T>& a, const Coo<K>& x, int threads=maxThreads()) {
+  hybridCsrDispatch<T>(a.blockSize, [&](auto B) {
+    HybridCsr<O, T, B()> b; hybridCsrFromCooOmp(b, x, threads);
+    a.sourceOffsets      = move(b.sourceOffsets);
+    a.destinationIndices = move(b.destinationIndices);
+  });
+}
+
+template <class O=int, class K, class T>
+auto hybridCsrFromCooOmp(const Coo<K>& x, T blk, int threads=maxThreads()) {
+  HybridCsr<O, T> a(blk); hybridCsrFromCooOmp(a, x, threads);
+  return a;
 }
 
 
@@ -305,32 +585,24 @@ auto hybridCsr(const G& x, K blk) {
 // HYBRID-CSR PRINT
 // ----------------
 
-template <class T, class U>
-void write(ostream& a, const HybridCsr<T, U>& x, bool all=false) {
-  const auto& vto = x.sourceOffsets;
-  const auto& eto = x.destinationIndices;
+template <class T, class U, int BLK>
+void write(ostream& a, const HybridCsr<T, U, BLK>& x, bool all=false) {
   a << "order: " << csrOrder(x) << " size: " << csrSize(x);
   if (!all) { a << " {}"; return; }
   a << " {\n";
-  int blk = x.blockSize, blk2 = int(log(blk)/log(2));
   for (int u=0, N=csrOrder(x); u<N; u++) {
     a << "  " << u << " ->";
-    for (T j=vto[u], J=vto[u+1]; j<J; j++) {
-      U pre = hybridCsrEntryId(eto[j], blk) << blk2;
-      U dat = hybridCsrEntryBlock(eto[j], blk);
-      for (int b=0; dat>0; dat>>=1, b++)
-        if (dat & 1) a << " " << pre + b;
-    }
+    csrForEachEdge(x, u, [&](auto v) { a << " " << v; });
     a << "\n";
   }
   a << "}";
 }
 
-template <class T, class U>
-void print(const HybridCsr<T, U>& x, bool all=false) { write(cout, x, all); }
+template <class T, class U, int BLK>
+void print(const HybridCsr<T, U, BLK>& x, bool all=false) { write(cout, x, all); }
 
-template <class T, class U>
-void println(const HybridCsr<T, U>& x, bool all=false) { print(x, all); cout << "\n"; }
+template <class T, class U, int BLK>
+void println(const HybridCsr<T, U, BLK>& x, bool all=false) { print(x, all); cout << "\n"; }
 
 
 
@@ -0,0 +1,287 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "_main.hxx"
+#include "csr.hxx"
+
+using std::FILE;
+using std::fopen;
+using std::fwrite;
+using std::fclose;
+using std::memcmp;
+using std::memcpy;
+using std::uint32_t;
+using std::uint64_t;
+using std::pair;
+
+
+
+
+// CSR-FILE HEADER
+// ---------------
+// Binary container for regular (block size 0) and hybrid CSR, in host byte
+// order: a header, then page-aligned source-offsets and destination-indices.
+
+const char     CSR_FILE_MAGIC[8] = {'C', 'S', 'R', 'F', 'I', 'L', 'E', '\0'};
+const uint32_t CSR_FILE_VERSION  = 1;
+const size_t   CSR_FILE_PAGE     = 4096;
+
+struct CsrFileHeader {
+  char     magic[8];
+  uint32_t version;
+  uint32_t blockSize;
+  uint32_t offsetBytes;
+  uint32_t indexBytes;
+  uint64_t order;
+  uint64_t size;
+  uint64_t entries;
+  uint64_t offsetsBegin;
+  uint64_t indicesBegin;
+};
+
+
+inline size_t csrFilePageAlign(size_t n) {
+  return (n + CSR_FILE_PAGE-1) & ~(CSR_FILE_PAGE-1);
+}
+
+
+// Check header against file size, and expected entry widths (and block size).
+inline bool csrFileHeaderValid(const CsrFileHeader& h, size_t N, size_t tb, size_t ub) {
+  if (memcmp(h.magic, CSR_FILE_MAGIC, sizeof(h.magic))!=0) return false;
+  if (h.version!=CSR_FILE_VERSION) return false;
+  if (h.offsetBytes!=tb || h.indexBytes!=ub) return false;
+  if (h.blockSize>32 || (h.blockSize & (h.blockSize-1))) return false;
+  if (h.offsetsBegin % CSR_FILE_PAGE || h.indicesBegin % CSR_FILE_PAGE) return false;
+  if (h.offsetsBegin + (h.order+1)*tb > h.indicesBegin) return false;
+  return h.indicesBegin + h.entries*ub <= N;
+}
+
+
+// Check ends of offsets against entries (rows in between are trusted).
+template <class T>
+inline bool csrFileOffsetsValid(const CsrFileHeader& h, const char *data) {
+  const T *vto = (const T*) (data + h.offsetsBegin);
+  return uint64_t(vto[0])==0 && uint64_t(vto[h.order])==h.entries;
+}
+
+
+
+
+// WRITE-CSR-FILE
+// --------------
+// Stream header, offsets, and indices, padding each section to a page.
+
+template <class T, class U>
+bool writeCsrFile(const char *pth, int blk, size_t S, const T *vto, size_t N, const U *eto, size_t M) {
+  CsrFileHeader h = {};
+  memcpy(h.magic, CSR_FILE_MAGIC, sizeof(h.magic));
+  h.version      = CSR_FILE_VERSION;
+  h.blockSize    = blk;
+  h.offsetBytes  = sizeof(T);
+  h.indexBytes   = sizeof(U);
+  h.order        = N;
+  h.size         = S;
+  h.entries      = M;
+  h.offsetsBegin = csrFilePageAlign(sizeof(h));
+  h.indicesBegin = csrFilePageAlign(h.offsetsBegin + (N+1)*sizeof(T));
+  static const char pad[CSR_FILE_PAGE] = {};
+  FILE *f = fopen(pth, "wb");
+  if (!f) return false;
+  size_t n = 0;
+  auto put = [&](const void *p, size_t b) {
+    if (fwrite(p, 1, b, f)!=b) return false;
+    n += b; return true;
+  };
+  bool ok = put(&h, sizeof(h))
+    && put(pad, h.offsetsBegin-n) && put(vto, (N+1)*sizeof(T))
+    && put(pad, h.indicesBegin-n) && put(eto, M*sizeof(U))
+    && put(pad, csrFilePageAlign(n)-n);
+  return fclose(f)==0 && ok;
+}
+
+
+template <class T, class U>
+bool writeCsrFile(const char *pth, const Csr<T, U>& x) {
+  const auto& vto = x.sourceOffsets;
+  const auto& eto = x.destinationIndices;
+  return writeCsrFile(pth, 0, eto.size(), vto.data(), vto.size()-1, eto.data(), eto.size());
+}
+
+
+template <class T, class U, int BLK>
+bool writeCsrFile(const char *pth, const HybridCsr<T, U, BLK>& x) {
+  const auto& vto = x.sourceOffsets;
+  const auto& eto = x.destinationIndices;
+  return writeCsrFile(pth, x.blockSize, csrSize(x), vto.data(), vto.size()-1, eto.data(), eto.size());
+}
+
+
+
+
+// CSR-VIEW
+// --------
+// Read-only CSR over a mapped file (shared with other processes via page cache).
+
+template <class T, class U=T>
+struct CsrView {
+  const T *sourceOffsets = nullptr;
+  const U *destinationIndices = nullptr;
+  size_t order = 0;
+  pair<const char*, size_t> file;
+};
+
+
+template <class T, class U=T, int BLK=0>
+struct HybridCsrView {
+  static constexpr int blockSize = BLK;
+  const T *sourceOffsets = nullptr;
+  const U *destinationIndices = nullptr;
+  size_t order = 0;
+  size_t size  = 0;
+  pair<const char*, size_t> file;
+};
+
+template <class T, class U>
+struct HybridCsrView<T, U, 0> {
+  int blockSize = 0;
+  const T *sourceOffsets = nullptr;
+  const U *destinationIndices = nullptr;
+  size_t order = 0;
+  size_t size  = 0;
+  pair<const char*, size_t> file;
+};
+
+
+
+
+// READ-CSR-FILE-VIEW
+// ------------------
+// Map file and point view into it (no copy); false if file does not match
+// (view is left as it was). A view already open is unmapped on success.
+
+template <class T, class U>
+bool readCsrFileView(CsrView<T, U>& a, const char *pth) {
+  auto f = mapFileRead(pth);
+  const CsrFileHeader *h = (const CsrFileHeader*) f.first;
+  if (!f.first || f.second<sizeof(*h) || !csrFileHeaderValid(*h, f.second, sizeof(T), sizeof(U)) || h->blockSize!=0
+    || !csrFileOffsetsValid<T>(*h, f.first)) { unmapFile(f); return false; }
+  unmapFile(a.file);
+  a.sourceOffsets      = (const T*) (f.first + h->offsetsBegin);
+  a.destinationIndices = (const U*) (f.first + h->indicesBegin);
+  a.order = h->order;
+  a.file  = f;
+  return true;
+}
+
+template <class T, class U, int BLK>
+bool readCsrFileView(HybridCsrView<T, U, BLK>& a, const char *pth) {
+  auto f = mapFileRead(pth);
+  const CsrFileHeader *h = (const CsrFileHeader*) f.first;
+  if (!f.first || f.second<sizeof(*h) || !csrFileHeaderValid(*h, f.second, sizeof(T), sizeof(U)) || h->blockSize==0 || h->blockSize>=8*sizeof(U)
+    || (BLK>0 && h->blockSize!=BLK) || !csrFileOffsetsValid<T>(*h, f.first)) { unmapFile(f); return false; }
+  unmapFile(a.file);
+  if constexpr (BLK==0) a.blockSize = h->blockSize;
+  a.sourceOffsets      = (const T*) (f.first + h->offsetsBegin);
+  a.destinationIndices = (const U*) (f.first + h->indicesBegin);
+  a.order = h->order;
+  a.size  = h->size;
+  a.file  = f;
+  return true;
+}
+
+
+template <class T, class U>
+void closeCsrFileView(CsrView<T, U>& a) {
+  unmapFile(a.file);
+  a = CsrView<T, U>();
+}
+
+template <class T, class U, int BLK>
+void closeCsrFileView(HybridCsrView<T, U, BLK>& a) {
+  unmapFile(a.file);
+  a = HybridCsrView<T, U, BLK>();
+}
+
+
+
+
+// CSR-VIEW GRAPH-LIKE
+// -------------------
+
+template <class T, class U>
+int csrOrder(const CsrView<T, U>& x) {
+  return x.order;
+}
+
+
+template <class T, class U>
+size_t csrSize(const CsrView<T, U>& x) {
+  return x.sourceOffsets? x.sourceOffsets[x.order] : 0;
+}
+
+
+template <class T, class U>
+int csrDegree(const CsrView<T, U>& x, T u) {
+  const T *vto = x.sourceOffsets;
+  return vto[u+1] - vto[u];
+}
+
+
+template <class T, class U>
+auto csrVertices(const CsrView<T, U>& x) {
+  return rangeIter(csrOrder(x));
+}
+
+
+template <class T, class U, class F>
+void csrForEachEdge(const CsrView<T, U>& x, size_t u, F fn) {
+  const T *vto = x.sourceOffsets;
+  const U *eto = x.destinationIndices;
+  for (T i=vto[u], I=vto[u+1]; i<I; i++)
+    fn(eto[i]);
+}
+
+
+
+
+// HYBRID-CSR-VIEW GRAPH-LIKE
+// --------------------------
+
+template <class T, class U, int BLK>
+int csrOrder(const HybridCsrView<T, U, BLK>& x) {
+  return x.order;
+}
+
+
+template <class T, class U, int BLK>
+size_t csrSize(const HybridCsrView<T, U, BLK>& x) {
+  return x.size;
+}
+
+
+template <class T, class U, int BLK>
+int csrDegree(const HybridCsrView<T, U, BLK>& x, T u) {
+  const T *vto = x.sourceOffsets;
+  const U *ib  = x.destinationIndices + vto[u];
+  const U *ie  = x.destinationIndices + vto[u+1];
+  if constexpr (BLK>0) return hybridCsrRowDegree<BLK>(ib, ie);
+  else return hybridCsrDispatch<U>(x.blockSize, [&](auto B) { return hybridCsrRowDegree<B()>(ib, ie); });
+}
+
+
+template <class T, class U, int BLK>
+auto csrVertices(const HybridCsrView<T, U, BLK>& x) {
+  return rangeIter(csrOrder(x));
+}
+
+
+template <class T, class U, int BLK, class F>
+void csrForEachEdge(const HybridCsrView<T, U, BLK>& x, size_t u, F fn) {
+  const T *vto = x.sourceOffsets;
+  const U *ib  = x.destinationIndices + vto[u];
+  const U *ie  = x.destinationIndices + vto[u+1];
+  if constexpr (BLK>0) hybridCsrRowForEachEdge<BLK>(ib, ie, fn);
+  else hybridCsrDispatch<U>(x.blockSize, [&](auto B) { hybridCsrRowForEachEdge<B()>(ib, ie, fn); });
+}
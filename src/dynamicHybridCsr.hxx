@@ -0,0 +1,290 @@
+#pragma once
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "_main.hxx"
+#include "coo.hxx"
+#include "csr.hxx"
+
+using std::vector;
+using std::pair;
+using std::move;
+using std::min;
+using std::max;
+using std::ceil;
+using std::log2;
+using std::sort;
+using std::copy;
+using std::remove_if;
+
+
+
+
+// DYNAMIC-HYBRID-CSR
+// ------------------
+// Hybrid CSR with free space after each row (packed-memory-array style).
+// Row u holds sourceSizes[u] entries (sorted by index-bits), in a slot of
+// sourceOffsets[u+1]-sourceOffsets[u] entries. A row that overflows borrows
+// space from the smallest window of neighbouring rows below its density
+// threshold; the whole structure is laid out again only if no window is.
+
+template <class T, class U=T, int BLK=8>
+struct DynamicHybridCsr {
+  static constexpr int blockSize = BLK;
+  vector<T> sourceOffsets;
+  vector<T> sourceSizes;
+  vector<U> destinationIndices;
+  double slack      = 0.25;  // free space per row, on layout (density 0.8)
+  double maxDensity = 0.90;  // threshold of whole structure (rows allow 1.0)
+  double minDensity = 0.25;  // compact when overall density falls below
+};
+
+
+
+
+// DYNAMIC-HYBRID-CSR GRAPH-LIKE
+// -----------------------------
+
+template <class T, class U, int BLK>
+int csrOrder(const DynamicHybridCsr<T, U, BLK>& x) {
+  return x.sourceOffsets.size()-1;
+}
+
+
+template <class T, class U, int BLK>
+int csrDegree(const DynamicHybridCsr<T, U, BLK>& x, T u) {
+  const U *ib = x.destinationIndices.data() + x.sourceOffsets[u];
+  return hybridCsrRowDegree<BLK>(ib, ib + x.sourceSizes[u]);
+}
+
+
+template <class T, class U, int BLK>
+size_t csrSize(const DynamicHybridCsr<T, U, BLK>& x) {
+  size_t a = 0;
+  for (T u=0, N=csrOrder(x); u<N; u++)
+    a += csrDegree(x, u);
+  return a;
+}
+
+
+template <class T, class U, int BLK>
+auto csrVertices(const DynamicHybridCsr<T, U, BLK>& x) {
+  return rangeIter(csrOrder(x));
+}
+
+
+template <class T, class U, int BLK, class F>
+void csrForEachEdge(const DynamicHybridCsr<T, U, BLK>& x, size_t u, F fn) {
+  const U *ib = x.destinationIndices.data() + x.sourceOffsets[u];
+  hybridCsrRowForEachEdge<BLK>(ib, ib + x.sourceSizes[u], fn);
+}
+
+
+
+
+// DYNAMIC-HYBRID-CSR LAYOUT
+// -------------------------
+// Give each row its entries (plus extra), and slack, in a new array.
+// Slack is raised if needed to keep the new layout under maxDensity (with
+// some margin), so that the whole-structure window can take inserts.
+
+template <class T, class U, int BLK>
+void dynamicHybridCsrLayoutOmp(DynamicHybridCsr<T, U, BLK>& a, const vector<T>& extra, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& vsz = a.sourceSizes;
+  auto& eto = a.destinationIndices;
+  size_t N = csrOrder(a);
+  double s = max(a.slack, 1/(0.9*a.maxDensity) - 1);
+  vector<T> wto(N+1);
+  #pragma omp parallel for schedule(static,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++) {
+    size_t n = vsz[u] + (extra.empty()? 0 : extra[u]);
+    wto[u+1] = n + T(ceil(n * s));
+  }
+  inclusiveScanOmp(wto, threads);
+  vector<U> fto(wto[N]);
+  #pragma omp parallel for schedule(dynamic,2048) num_threads(threads)
+  for (size_t u=0; u<N; u++)
+    copy(eto.begin()+vto[u], eto.begin()+vto[u]+vsz[u], fto.begin()+wto[u]);
+  vto = move(wto);
+  eto = move(fto);
+}
+
+
+
+
+// DYNAMIC-HYBRID-CSR REBALANCE
+// ----------------------------
+// Make room for k more entries in row u, by spreading free space evenly
+// over the smallest aligned window of 2^l rows under its density threshold
+// (1.0 for a single row, down to maxDensity for all rows).
+
+template <class T, class U, int BLK>
+bool dynamicHybridCsrRebalance(DynamicHybridCsr<T, U, BLK>& a, size_t u, size_t k) {
+  auto& vto = a.sourceOffsets;
+  auto& vsz = a.sourceSizes;
+  auto& eto = a.destinationIndices;
+  size_t N = csrOrder(a);
+  int H = N>1? int(ceil(log2(N))) : 1;
+  vector<U> buf;
+  for (int l=1; l<=H; l++) {
+    size_t w = size_t(1) << l, ub = u & ~(w-1), ue = min(ub+w, N);
+    size_t cap = vto[ue] - vto[ub], used = k;
+    for (size_t r=ub; r<ue; r++)
+      used += vsz[r];
+    if (used > cap * (1 - (1-a.maxDensity)*l/H)) continue;
+    // Move entries of window out, and back with free space spread evenly.
+    buf.clear();
+    for (size_t r=ub; r<ue; r++)
+      buf.insert(buf.end(), eto.begin()+vto[r], eto.begin()+vto[r]+vsz[r]);
+    size_t R = ue-ub, free = cap-used, i = 0;
+    for (size_t r=ub; r<ue; r++) {
+      size_t n = vsz[r] + (r==u? k : 0) + free/R + (r-ub < free%R);
+      copy(buf.begin()+i, buf.begin()+i+vsz[r], eto.begin()+vto[r]);
+      i += vsz[r];
+      vto[r+1] = vto[r] + n;
+    }
+    return true;
+  }
+  return false;
+}
+
+
+
+
+// DYNAMIC-HYBRID-CSR UPDATE
+// -------------------------
+
+// Find entry with given index-bits in row [ib, ib+N), or N.
+template <int BLK, class U>
+size_t dynamicHybridCsrRowFind(const U *ib, size_t N, U vid) {
+  auto fl = [](U e, U vid) { return hybridCsrEntryId<BLK>(e) < vid; };
+  const U *it = lowerBoundBranchless(ib, N, vid, fl);
+  return it<ib+N && hybridCsrEntryId<BLK>(*it)==vid? it-ib : N;
+}
+
+
+// Merge sorted new entries [nb, nb+M) into row [ib, ib+N), from the back.
+template <int BLK, class U>
+void dynamicHybridCsrRowMerge(U *ib, size_t N, const U *nb, size_t M) {
+  for (size_t i=N, j=M, k=N+M; j>0;) {
+    if (i>0 && hybridCsrEntryId<BLK>(ib[i-1]) > hybridCsrEntryId<BLK>(nb[j-1])) ib[--k] = ib[--i];
+    else ib[--k] = nb[--j];
+  }
+}
+
+
+// Start of each source's edges in a batch sorted by source (and end).
+template <class K>
+auto cooSourceGroups(const Coo<K>& x) {
+  vector<size_t> a;
+  for (size_t i=0, M=cooSize(x); i<M; i++)
+    if (i==0 || x.sources[i]!=x.sources[i-1]) a.push_back(i);
+  a.push_back(cooSize(x));
+  return a;
+}
+
+
+// Apply batch of edges, sorted by source then target (see cooDeduplicateOmp).
+template <class T, class U, int BLK, class K>
+void dynamicHybridCsrInsertOmp(DynamicHybridCsr<T, U, BLK>& a, const Coo<K>& x, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& vsz = a.sourceSizes;
+  auto& eto = a.destinationIndices;
+  auto gs = cooSourceGroups(x);
+  int G = gs.size()-1;
+  vector<pair<size_t, vector<U>>> ps;
+  // Set bits in existing entries, and merge new entries where the row has room.
+  #pragma omp parallel num_threads(threads)
+  {
+    vector<U> ns;
+    vector<pair<size_t, vector<U>>> qs;
+    #pragma omp for schedule(dynamic,256)
+    for (int g=0; g<G; g++) {
+      size_t u = x.sources[gs[g]], N = vsz[u];
+      U *ib = eto.data() + vto[u];
+      ns.clear();
+      for (size_t i=gs[g]; i<gs[g+1]; i++) {
+        U v = U(x.targets[i]), vid = hybridCsrValueId<BLK>(v);
+        if (!ns.empty() && hybridCsrEntryId<BLK>(ns.back())==vid) { ns.back() |= hybridCsrValueBlock<BLK>(v); continue; }
+        size_t j = dynamicHybridCsrRowFind<BLK>(ib, N, vid);
+        if (j<N) ib[j] |= hybridCsrValueBlock<BLK>(v);
+        else ns.push_back(hybridCsrValueEntry<BLK>(v));
+      }
+      if (ns.empty()) continue;
+      if (N + ns.size() > vto[u+1]-vto[u]) { qs.emplace_back(u, ns); continue; }
+      dynamicHybridCsrRowMerge<BLK>(ib, N, ns.data(), ns.size());
+      vsz[u] += ns.size();
+    }
+    #pragma omp critical
+    ps.insert(ps.end(), qs.begin(), qs.end());
+  }
+  // Rebalance overflowing rows, or lay out everything again if too dense.
+  sort(ps.begin(), ps.end(), [](const auto& p, const auto& q) { return p.first < q.first; });
+  for (size_t i=0, P=ps.size(); i<P; i++) {
+    size_t u = ps[i].first;
+    const auto& ns = ps[i].second;
+    bool room = vsz[u] + ns.size() <= vto[u+1]-vto[u];
+    if (!room && !dynamicHybridCsrRebalance(a, u, ns.size())) {
+      vector<T> extra(csrOrder(a));
+      for (size_t j=i; j<P; j++)
+        extra[ps[j].first] = ps[j].second.size();
+      dynamicHybridCsrLayoutOmp(a, extra, threads);
+    }
+    dynamicHybridCsrRowMerge<BLK>(eto.data()+vto[u], vsz[u], ns.data(), ns.size());
+    vsz[u] += ns.size();
+  }
+}
+
+
+// Remove batch of edges, sorted by source then target (see cooDeduplicateOmp).
+template <class T, class U, int BLK, class K>
+void dynamicHybridCsrRemoveOmp(DynamicHybridCsr<T, U, BLK>& a, const Coo<K>& x, int threads=maxThreads()) {
+  auto& vto = a.sourceOffsets;
+  auto& vsz = a.sourceSizes;
+  auto& eto = a.destinationIndices;
+  auto gs = cooSourceGroups(x);
+  int G = gs.size()-1;
+  // Clear bits, and drop entries left with no bits.
+  #pragma omp parallel for schedule(dynamic,256) num_threads(threads)
+  for (int g=0; g<G; g++) {
+    size_t u = x.sources[gs[g]], N = vsz[u];
+    U *ib = eto.data() + vto[u];
+    bool empty = false;
+    for (size_t i=gs[g]; i<gs[g+1]; i++) {
+      U v = U(x.targets[i]);
+      size_t j = dynamicHybridCsrRowFind<BLK>(ib, N, hybridCsrValueId<BLK>(v));
+      if (j==N) continue;
+      ib[j] &= ~hybridCsrValueBlock<BLK>(v);
+      if (!hybridCsrEntryBlock<BLK>(ib[j])) empty = true;
+    }
+    if (empty) vsz[u] = remove_if(ib, ib+N, [](U e) { return !hybridCsrEntryBlock<BLK>(e); }) - ib;
+  }
+  // Compact if too sparse.
+  size_t used = 0, N = csrOrder(a);
+  #pragma omp parallel for schedule(static,2048) num_threads(threads) reduction(+:used)
+  for (size_t u=0; u<N; u++)
+    used += vsz[u];
+  if (used < a.minDensity * eto.size()) dynamicHybridCsrLayoutOmp(a, vector<T>(), threads);
+}
+
+
+
+
+// DYNAMIC-HYBRID-CSR (FROM EDGE-LIST)
+// -----------------------------------
+
+template <int BLK, class K, class U>
+auto dynamicHybridCsrFromCooOmp(const Coo<K>& x, U typ, int threads=maxThreads()) {
+  DynamicHybridCsr<size_t, U, BLK> a;
+  HybridCsr<size_t, U, BLK> b; hybridCsrFromCooOmp(b, x, threads);
+  size_t N = cooOrder(x);
+  a.sourceSizes.resize(N);
+  for (size_t u=0; u<N; u++)
+    a.sourceSizes[u] = b.sourceOffsets[u+1] - b.sourceOffsets[u];
+  a.sourceOffsets      = move(b.sourceOffsets);
+  a.destinationIndices = move(b.destinationIndices);
+  dynamicHybridCsrLayoutOmp(a, vector<size_t>(), threads);
+  return a;
+}
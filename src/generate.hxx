@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "_main.hxx"
+#include "coo.hxx"
+
+using std::uint64_t;
+using std::mt19937_64;
+using std::uniform_real_distribution;
+using std::vector;
+using std::shuffle;
+using std::min;
+
+
+
+
+// GENERATE-*
+// ----------
+// Synthetic graphs as edge lists (may have duplicates, see cooDeduplicateOmp).
+// Edges are generated in chunks, each with its own seed, so that the result
+// depends only on the seed (not on the number of threads).
+
+const size_t GENERATE_CHUNK = 65536;
+
+template <class K, class F>
+void generateChunksOmp(Coo<K>& a, size_t M, uint64_t seed, F fn) {
+  a.sources.resize(M);
+  a.targets.resize(M);
+  size_t C = (M + GENERATE_CHUNK-1) / GENERATE_CHUNK;
+  #pragma omp parallel for schedule(dynamic,1)
+  for (size_t c=0; c<C; c++) {
+    mt19937_64 rnd(seed + c);
+    for (size_t i=c*GENERATE_CHUNK, I=min(i+GENERATE_CHUNK, M); i<I; i++)
+      fn(rnd, i, a.sources[i], a.targets[i]);
+  }
+}
+
+
+
+
+// GENERATE-RMAT
+// -------------
+// R-MAT (Kronecker) graph with 2^scale vertices and edgeFactor edges per
+// vertex, quadrant probabilities (a, b, c, 1-a-b-c), and vertex-ids shuffled
+// (as in Graph500).
+
+template <class K=int>
+auto generateRmatOmp(int scale, int edgeFactor, uint64_t seed=42, double a=0.57, double b=0.19, double c=0.19) {
+  Coo<K> x;
+  size_t N = size_t(1) << scale, M = N * edgeFactor;
+  vector<K> ks(N);
+  for (size_t i=0; i<N; i++)
+    ks[i] = K(i);
+  mt19937_64 rnd(seed);
+  shuffle(ks.begin(), ks.end(), rnd);
+  x.order = K(N);
+  generateChunksOmp(x, M, seed+1, [&](auto& rnd, size_t i, K& u, K& v) {
+    uniform_real_distribution<double> dis(0, 1);
+    size_t p = 0, q = 0;
+    for (int l=0; l<scale; l++) {
+      double r = dis(rnd);
+      int bi = r>=a+b, bj = (r>=a && r<a+b) || r>=a+b+c;
+      p = (p<<1) | bi;
+      q = (q<<1) | bj;
+    }
+    u = ks[p]; v = ks[q];
+  });
+  return x;
+}
+
+
+
+
+// GENERATE-ERDOS-RENYI
+// --------------------
+// Uniform random graph G(n, m), without self-loops.
+
+template <class K=int>
+auto generateErdosRenyiOmp(size_t N, size_t M, uint64_t seed=42) {
+  Coo<K> x;
+  x.order = K(N);
+  if (N<2) return x;
+  generateChunksOmp(x, M, seed, [&](auto& rnd, size_t i, K& u, K& v) {
+    u = K(rnd() % N);
+    v = K(rnd() % (N-1));
+    if (v>=u) ++v;
+  });
+  return x;
+}
+
+
+
+
+// GENERATE-GRID
+// -------------
+// Road-like graph: rows x cols grid (row-major ids), with each street
+// (pair of opposite edges) between neighbours kept with probability p.
+
+template <class K=int>
+auto generateGridOmp(size_t R, size_t C, double p=0.9, uint64_t seed=42) {
+  Coo<K> x, y;
+  x.order = K(R*C);
+  // Street i joins cell i/2 to its right (even i) or lower (odd i) neighbour.
+  generateChunksOmp(y, 2*R*C, seed, [&](auto& rnd, size_t i, K& u, K& v) {
+    uniform_real_distribution<double> dis(0, 1);
+    size_t k = i/2;
+    size_t r = k/C, c = k%C;
+    bool ok = dis(rnd) < p && (i%2? r+1<R : c+1<C);
+    u = ok? K(k) : K(-1);
+    v = ok? K(i%2? k+C : k+1) : K(-1);
+  });
+  for (size_t i=0, I=cooSize(y); i<I; i++) {
+    if (y.sources[i]<0) continue;
+    x.sources.push_back(y.sources[i]); x.targets.push_back(y.targets[i]);
+    x.sources.push_back(y.targets[i]); x.targets.push_back(y.sources[i]);
+  }
+  return x;
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "_main.hxx"
+#include "csr.hxx"
+
+using std::uint32_t;
+using std::uint64_t;
+using std::conditional_t;
+
+
+
+
+// SIMD-LEVEL
+// ----------
+// Widest vector extension usable on this CPU (may be lowered to compare).
+// Only x86 has SIMD kernels, elsewhere rows are scanned with scalar code.
+
+const int SIMD_SCALAR = 0;
+const int SIMD_AVX2   = 1;
+const int SIMD_AVX512 = 2;
+
+int simdLevelDetect() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+  if (__builtin_cpu_supports("avx2"))    return SIMD_AVX2;
+#endif
+  return SIMD_SCALAR;
+}
+
+inline int simdLevel = simdLevelDetect();
+
+
+
+
+// HYBRID-CSR-ROW-FIND
+// -------------------
+// Index of entry with given index-bits (e >> BLK == vid) in a row, or -1.
+// With BLK=0, entries are plain vertex ids (regular CSR).
+
+template <int BLK, class U>
+int hybridCsrRowFindScalar(const U *ib, size_t N, U vid) {
+  for (size_t i=0; i<N; i++)
+    if (hybridCsrEntryId<BLK>(ib[i]) == vid) return i;
+  return -1;
+}
+
+
+// SIMD kernels compare index-bits in place (e & ~block == vid << BLK).
+#if defined(__x86_64__) || defined(__i386__)
+template <int BLK>
+__attribute__((target("avx2")))
+int hybridCsrRowFindAvx2(const uint32_t *ib, size_t N, uint32_t vid) {
+  __m256i h = _mm256_set1_epi32(zeroBits(uint32_t(BLK)));
+  __m256i k = _mm256_set1_epi32(vid << BLK);
+  size_t i = 0;
+  for (; i+8<=N; i+=8) {
+    __m256i e = _mm256_loadu_si256((const __m256i*) (ib+i));
+    __m256i c = _mm256_cmpeq_epi32(_mm256_and_si256(e, h), k);
+    uint32_t m = _mm256_movemask_ps(_mm256_castsi256_ps(c));
+    if (m) return i + countTrailingZeros(m);
+  }
+  int j = hybridCsrRowFindScalar<BLK>(ib+i, N-i, vid);
+  return j<0? -1 : i+j;
+}
+
+template <int BLK>
+__attribute__((target("avx2")))
+int hybridCsrRowFindAvx2(const uint64_t *ib, size_t N, uint64_t vid) {
+  __m256i h = _mm256_set1_epi64x(zeroBits(uint64_t(BLK)));
+  __m256i k = _mm256_set1_epi64x(vid << BLK);
+  size_t i = 0;
+  for (; i+4<=N; i+=4) {
+    __m256i e = _mm256_loadu_si256((const __m256i*) (ib+i));
+    __m256i c = _mm256_cmpeq_epi64(_mm256_and_si256(e, h), k);
+    uint32_t m = _mm256_movemask_pd(_mm256_castsi256_pd(c));
+    if (m) return i + countTrailingZeros(m);
+  }
+  int j = hybridCsrRowFindScalar<BLK>(ib+i, N-i, vid);
+  return j<0? -1 : i+j;
+}
+
+
+template <int BLK>
+__attribute__((target("avx512f")))
+int hybridCsrRowFindAvx512(const uint32_t *ib, size_t N, uint32_t vid) {
+  __m512i h = _mm512_set1_epi32(zeroBits(uint32_t(BLK)));
+  __m512i k = _mm512_set1_epi32(vid << BLK);
+  size_t i = 0;
+  for (; i+16<=N; i+=16) {
+    __m512i e = _mm512_loadu_si512((const void*) (ib+i));
+    uint32_t m = _mm512_cmpeq_epi32_mask(_mm512_and_si512(e, h), k);
+    if (m) return i + countTrailingZeros(m);
+  }
+  int j = hybridCsrRowFindScalar<BLK>(ib+i, N-i, vid);
+  return j<0? -1 : i+j;
+}
+
+template <int BLK>
+__attribute__((target("avx512f")))
+int hybridCsrRowFindAvx512(const uint64_t *ib, size_t N, uint64_t vid) {
+  __m512i h = _mm512_set1_epi64(zeroBits(uint64_t(BLK)));
+  __m512i k = _mm512_set1_epi64(vid << BLK);
+  size_t i = 0;
+  for (; i+8<=N; i+=8) {
+    __m512i e = _mm512_loadu_si512((const void*) (ib+i));
+    uint32_t m = _mm512_cmpeq_epi64_mask(_mm512_and_si512(e, h), k);
+    if (m) return i + countTrailingZeros(m);
+  }
+  int j = hybridCsrRowFindScalar<BLK>(ib+i, N-i, vid);
+  return j<0? -1 : i+j;
+}
+#endif
+
+
+// Short rows are scanned with SIMD, long (sorted) rows are binary searched.
+template <int BLK, class U>
+int hybridCsrRowFind(const U *ib, size_t N, U vid) {
+  const size_t SCAN = 64;
+  if (N>SCAN) {
+    auto fl = [](U e, U vid) { return hybridCsrEntryId<BLK>(e) < vid; };
+    const U *it = lowerBoundBranchless(ib, N, vid, fl);
+    return it<ib+N && hybridCsrEntryId<BLK>(*it)==vid? it-ib : -1;
+  }
+#if defined(__x86_64__) || defined(__i386__)
+  if constexpr (sizeof(U)==4 || sizeof(U)==8) {
+    using V = conditional_t<sizeof(U)==4, uint32_t, uint64_t>;
+    const V *jb = (const V*) ib;
+    if (simdLevel>=SIMD_AVX512) return hybridCsrRowFindAvx512<BLK>(jb, N, V(vid));
+    if (simdLevel>=SIMD_AVX2)   return hybridCsrRowFindAvx2<BLK>(jb, N, V(vid));
+  }
+#endif
+  return hybridCsrRowFindScalar<BLK>(ib, N, vid);
+}
+
+
+
+
+// CSR-HAS-EDGE
+// ------------
+// Rows must be sorted (as built from an edge list, or hybrid).
+
+template <class T, class U>
+bool csrHasEdge(const Csr<T, U>& x, size_t u, U v) {
+  const auto& vto = x.sourceOffsets;
+  const U *ib = x.destinationIndices.data() + vto[u];
+  return hybridCsrRowFind<0>(ib, vto[u+1]-vto[u], v) >= 0;
+}
+
+
+template <int BLK, class U>
+bool hybridCsrRowHasEdge(const U *ib, size_t N, U v) {
+  int i = hybridCsrRowFind<BLK>(ib, N, hybridCsrValueId<BLK>(v));
+  return i>=0 && (ib[i] & hybridCsrValueBlock<BLK>(v));
+}
+
+template <class T, class U, int BLK>
+bool csrHasEdge(const HybridCsr<T, U, BLK>& x, size_t u, U v) {
+  const auto& vto = x.sourceOffsets;
+  const U *ib = x.destinationIndices.data() + vto[u];
+  size_t N = vto[u+1] - vto[u];
+  if constexpr (BLK>0) return hybridCsrRowHasEdge<BLK>(ib, N, v);
+  else return hybridCsrDispatch<U>(x.blockSize, [&](auto B) { return hybridCsrRowHasEdge<B()>(ib, N, v); });
+}
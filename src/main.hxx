@@ -2,8 +2,18 @@
 #include "_main.hxx"
 #include "DiGraph.hxx"
 #include "vertices.hxx"
+#include "ordering.hxx"
 #include "edges.hxx"
+#include "coo.hxx"
 #include "csr.hxx"
+#include "adaptiveCsr.hxx"
+#include "dynamicHybridCsr.hxx"
+#include "bfs.hxx"
+#include "spmv.hxx"
+#include "pagerank.hxx"
+#include "hasEdge.hxx"
 #include "mtx.hxx"
+#include "csrFile.hxx"
+#include "generate.hxx"
 #include "copy.hxx"
 #include "transpose.hxx"
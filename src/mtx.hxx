@@ -1,13 +1,18 @@
 #pragma once
+#include <cstring>
 #include <string>
+#include <vector>
 #include <istream>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 #include "_main.hxx"
 #include "DiGraph.hxx"
+#include "coo.hxx"
 
+using std::memchr;
 using std::string;
+using std::vector;
 using std::istream;
 using std::stringstream;
 using std::ofstream;
@@ -74,6 +79,135 @@ auto readMtx(const char *pth) {
 
 
 
+// READ-MTX-COO
+// ------------
+// Parse memory-mapped file in parallel chunks, into a flat edge list.
+
+inline bool isBlank(char c) {
+  return c==' ' || c=='\t' || c=='\r';
+}
+
+template <class K>
+inline const char* parseWholeNumber(K& a, const char *ib, const char *ie) {
+  K x = K();
+  for (; ib<ie && unsigned(*ib-'0')<10; ++ib)
+    x = x*K(10) + K(*ib-'0');
+  a = x;
+  return ib;
+}
+
+inline const char* nextLine(const char *ib, const char *ie) {
+  auto it = (const char*) memchr(ib, '\n', ie-ib);
+  return it? it+1 : ie;
+}
+
+
+// Returns largest (1-based) id read, as it may exceed the declared order.
+template <class K>
+K readMtxChunk(vector<K>& us, vector<K>& vs, const char *ib, const char *ie, bool sym) {
+  K n = K();
+  for (const char *it=ib; it<ie;) {
+    K u, v;
+    while (it<ie && isBlank(*it)) ++it;
+    const char *iu = it;
+    it = parseWholeNumber(u, it, ie);
+    bool hu = it>iu;
+    while (it<ie && isBlank(*it)) ++it;
+    const char *iv = it;
+    it = parseWholeNumber(v, it, ie);
+    bool hv = it>iv;
+    it = nextLine(it, ie);
+    if (!hu || !hv || u==K() || v==K()) continue;
+    us.push_back(u-1); vs.push_back(v-1);
+    if (sym && u!=v) { us.push_back(v-1); vs.push_back(u-1); }
+    n = max(n, max(u, v));
+  }
+  return n;
+}
+
+
+template <class K>
+void readMtxCooOmp(Coo<K>& a, const char *pth, bool dedup=false) {
+  const size_t CHUNK = 1 << 22;
+  auto fm = mapFileRead(pth);
+  const char *ib = fm.first, *ie = fm.first + fm.second, *it = ib;
+  string ln, h0, h1, h2, h3, h4;
+
+  // read header
+  while (it<ie) {
+    const char *il = nextLine(it, ie);
+    ln.assign(it, il); it = il;
+    if (ln.find('%')!=0) break;
+    if (ln.find("%%")!=0) continue;
+    stringstream ls(ln);
+    ls >> h0 >> h1 >> h2 >> h3 >> h4;
+  }
+  if (h1!="matrix" || h2!="coordinate") { unmapFile(fm); return; }
+  bool sym = h4=="symmetric" || h4=="skew-symmetric";
+
+  // read rows, cols, size
+  size_t r, c, sz;
+  stringstream ls(ln);
+  ls >> r >> c >> sz;
+  a.order = K(max(r, c));
+
+  // read edges (from, to), one chunk per task
+  size_t B = ie-it, C = max(size_t(1), B/CHUNK);
+  vector2d<K> us(C), vs(C);
+  vector<K> ns(C);
+  auto chunkBegin = [&](size_t i) { return i==0? it : i==C? ie : nextLine(it + B*i/C - 1, ie); };
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t i=0; i<C; i++)
+    ns[i] = readMtxChunk(us[i], vs[i], chunkBegin(i), chunkBegin(i+1), sym);
+  unmapFile(fm);
+  // Grow order to cover ids beyond the header (else later passes go out of bounds).
+  for (size_t i=0; i<C; i++)
+    a.order = max(a.order, ns[i]);
+
+  // join chunks
+  vector<size_t> offs(C+1);
+  for (size_t i=0; i<C; i++)
+    offs[i+1] = offs[i] + us[i].size();
+  a.sources.resize(offs[C]);
+  a.targets.resize(offs[C]);
+  #pragma omp parallel for schedule(dynamic, 1)
+  for (size_t i=0; i<C; i++) {
+    copy(us[i].begin(), us[i].end(), a.sources.begin()+offs[i]);
+    copy(vs[i].begin(), vs[i].end(), a.targets.begin()+offs[i]);
+    us[i] = vector<K>(); vs[i] = vector<K>();
+  }
+  if (dedup) cooDeduplicateOmp(a);
+}
+
+auto readMtxCooOmp(const char *pth, bool dedup=false) {
+  Coo<int> a; readMtxCooOmp(a, pth, dedup);
+  return a;
+}
+
+
+
+
+// READ-MTX-OMP
+// ------------
+// Fill graph from parallel parsed (and deduplicated) edge list.
+
+template <class G>
+void readMtxOmp(G& a, const char *pth) {
+  auto x = readMtxCooOmp(pth, true);
+  for (int u=1; u<=x.order; u++)
+    a.addVertex(u);
+  for (size_t i=0, M=cooSize(x); i<M; i++)
+    a.addEdgeUnchecked(x.sources[i]+1, x.targets[i]+1);
+}
+
+auto readMtxOmp(const char *pth) {
+  DiGraph<> a; readMtxOmp(a, pth);
+  return a;
+}
+
+
+
+
 // WRITE-MTX
 // ---------
 
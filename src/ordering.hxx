@@ -0,0 +1,175 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "_main.hxx"
+#include "vertices.hxx"
+
+using std::vector;
+using std::sort;
+using std::stable_sort;
+using std::stable_partition;
+using std::reverse;
+using std::swap;
+
+
+
+
+// DEGREE-ORDER
+// ------------
+// Vertices by decreasing degree (ties in original order).
+
+template <class G>
+auto degreeOrder(const G& x) {
+  auto a = vertices(x);
+  stable_sort(a.begin(), a.end(), [&](int u, int v) { return x.degree(u) > x.degree(v); });
+  return a;
+}
+
+
+
+
+// BFS-ORDER, DFS-ORDER
+// --------------------
+// Vertices in order of visit, starting from each unvisited vertex in turn.
+
+template <class G>
+auto bfsOrder(const G& x) {
+  vector<int> a;
+  vector<bool> vis(x.span());
+  for (int s : x.vertices()) {
+    if (vis[s]) continue;
+    size_t i = a.size();
+    vis[s] = true; a.push_back(s);
+    for (; i<a.size(); i++) {
+      for (int v : x.edges(a[i]))
+        if (!vis[v]) { vis[v] = true; a.push_back(v); }
+    }
+  }
+  return a;
+}
+
+
+template <class G>
+auto dfsOrder(const G& x) {
+  vector<int> a, q;
+  vector<bool> vis(x.span());
+  for (int s : x.vertices()) {
+    q.push_back(s);
+    while (!q.empty()) {
+      int u = q.back(); q.pop_back();
+      if (vis[u]) continue;
+      vis[u] = true; a.push_back(u);
+      auto es = x.edges(u);
+      for (auto it=es.end(); it!=es.begin();)
+        if (!vis[*--it]) q.push_back(*it);
+    }
+  }
+  return a;
+}
+
+
+
+
+// RCM-ORDER
+// ---------
+// Reverse Cuthill-McKee: BFS from lowest degree vertex of each component,
+// visiting neighbors by increasing degree, then reversed.
+
+template <class G>
+auto rcmOrder(const G& x) {
+  vector<int> a;
+  vector<bool> vis(x.span());
+  auto fl = [&](int u, int v) { return x.degree(u) < x.degree(v); };
+  auto ks = vertices(x);
+  stable_sort(ks.begin(), ks.end(), fl);
+  for (int s : ks) {
+    if (vis[s]) continue;
+    size_t i = a.size();
+    vis[s] = true; a.push_back(s);
+    for (; i<a.size(); i++) {
+      size_t j = a.size();
+      for (int v : x.edges(a[i]))
+        if (!vis[v]) { vis[v] = true; a.push_back(v); }
+      stable_sort(a.begin()+j, a.end(), fl);
+    }
+  }
+  reverse(a.begin(), a.end());
+  return a;
+}
+
+
+
+
+// HUB-CLUSTER-ORDER
+// -----------------
+// Hub vertices (above average degree) first, then the rest, both in original order.
+
+template <class G>
+auto hubClusterOrder(const G& x) {
+  auto a = vertices(x);
+  double d = x.order()? double(x.size())/x.order() : 0;
+  stable_partition(a.begin(), a.end(), [&](int u) { return x.degree(u) > d; });
+  return a;
+}
+
+
+
+
+// COMMUNITY-ORDER
+// ---------------
+// Clusters vertices with parallel label propagation, and then places the
+// members of each community together (in the style of Rabbit Order,
+// which instead aggregates communities incrementally). Labels are updated
+// in synchronous rounds (read a, write b), so the result is deterministic.
+
+template <class G>
+auto communityLabelsOmp(const G& x, int maxIterations=10, double tolerance=0.01) {
+  auto ks = vertices(x);
+  int N = ks.size();
+  vector<int> a(x.span());
+  for (int u : ks) a[u] = u;
+  vector<int> b = a;
+  for (int l=0; l<maxIterations; l++) {
+    int changed = 0;
+    #pragma omp parallel reduction(+:changed)
+    {
+      vector<int> ls;
+      #pragma omp for schedule(dynamic,2048)
+      for (int i=0; i<N; i++) {
+        int u = ks[i];
+        if (x.degree(u)==0) continue;
+        // Pick most frequent label among neighbors (and self), smallest on ties.
+        ls.clear(); ls.push_back(a[u]);
+        for (int v : x.edges(u))
+          ls.push_back(a[v]);
+        sort(ls.begin(), ls.end());
+        int c = ls[0], n = 0;
+        for (size_t j=0, J=ls.size(); j<J;) {
+          size_t k = j;
+          while (k<J && ls[k]==ls[j]) k++;
+          if (int(k-j) > n) { c = ls[j]; n = k-j; }
+          j = k;
+        }
+        b[u] = c;
+        if (c!=a[u]) changed++;
+      }
+    }
+    swap(a, b);
+    if (changed < tolerance*N) break;
+  }
+  return a;
+}
+
+
+template <class G>
+auto communityOrderOmp(const G& x) {
+  auto cs = communityLabelsOmp(x);
+  auto a  = vertices(x);
+  // Order communities by their first member, keep original order within.
+  vector<int> fs(x.span(), -1);
+  for (int i=0, N=a.size(); i<N; i++)
+    if (fs[cs[a[i]]]<0) fs[cs[a[i]]] = i;
+  stable_sort(a.begin(), a.end(), [&](int u, int v) { return fs[cs[u]] < fs[cs[v]]; });
+  return a;
+}
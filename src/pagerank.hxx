@@ -0,0 +1,150 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "_main.hxx"
+#include "csr.hxx"
+
+using std::vector;
+using std::swap;
+using std::move;
+
+
+
+
+// PAGERANK-OPTIONS
+// ----------------
+
+template <class T>
+struct PagerankOptions {
+  T   damping;
+  T   tolerance;
+  int maxIterations;
+
+  PagerankOptions(T damping=0.85, T tolerance=1e-6, int maxIterations=500) :
+  damping(damping), tolerance(tolerance), maxIterations(maxIterations) {}
+};
+
+
+
+
+// PAGERANK-RESULT
+// ---------------
+
+template <class T>
+struct PagerankResult {
+  vector<T> ranks;
+  int iterations;
+
+  PagerankResult(vector<T>&& ranks, int iterations) :
+  ranks(ranks), iterations(iterations) {}
+};
+
+
+
+
+// PAGERANK-PULL
+// -------------
+// Gather ranks over in-edges (xt is transpose of graph, degs are out-degrees).
+// Rank of dead ends is spread evenly across all vertices.
+
+template <class C, class T=double>
+auto pagerankPull(const C& xt, const vector<int>& degs, const PagerankOptions<T>& o=PagerankOptions<T>()) {
+  int N = csrOrder(xt), l = 0;
+  T p = o.damping, c0 = (1-p)/N;
+  vector<T> a(N), r(N, T(1)/N), cs(N);
+  while (l<o.maxIterations) {
+    T d = T();
+    for (int u=0; u<N; u++) {
+      cs[u] = degs[u]? r[u]/degs[u] : T();
+      if (!degs[u]) d += r[u]/N;
+    }
+    for (int v=0; v<N; v++) {
+      T s = T();
+      csrForEachEdge(xt, v, [&](auto u) { s += cs[u]; });
+      a[v] = c0 + p*(s + d);
+    }
+    T e = l1Norm(a, r); swap(a, r); ++l;
+    if (e<o.tolerance) break;
+  }
+  return PagerankResult<T>(move(r), l);
+}
+
+
+template <class C, class T=double>
+auto pagerankPullOmp(const C& xt, const vector<int>& degs, const PagerankOptions<T>& o=PagerankOptions<T>()) {
+  int N = csrOrder(xt), l = 0;
+  T p = o.damping, c0 = (1-p)/N;
+  vector<T> a(N), r(N, T(1)/N), cs(N);
+  while (l<o.maxIterations) {
+    T d = T();
+    #pragma omp parallel for schedule(static,2048) reduction(+:d)
+    for (int u=0; u<N; u++) {
+      cs[u] = degs[u]? r[u]/degs[u] : T();
+      if (!degs[u]) d += r[u]/N;
+    }
+    #pragma omp parallel for schedule(dynamic,2048)
+    for (int v=0; v<N; v++) {
+      T s = T();
+      csrForEachEdge(xt, v, [&](auto u) { s += cs[u]; });
+      a[v] = c0 + p*(s + d);
+    }
+    T e = l1NormOmp(a, r); swap(a, r); ++l;
+    if (e<o.tolerance) break;
+  }
+  return PagerankResult<T>(move(r), l);
+}
+
+
+
+
+// PAGERANK-PUSH
+// -------------
+// Scatter ranks over out-edges.
+
+template <class C, class T=double>
+auto pagerankPush(const C& x, const vector<int>& degs, const PagerankOptions<T>& o=PagerankOptions<T>()) {
+  int N = csrOrder(x), l = 0;
+  T p = o.damping, c0 = (1-p)/N;
+  vector<T> a(N), r(N, T(1)/N);
+  while (l<o.maxIterations) {
+    T d = T();
+    fill(a, T());
+    for (int u=0; u<N; u++) {
+      if (!degs[u]) { d += r[u]/N; continue; }
+      T c = r[u]/degs[u];
+      csrForEachEdge(x, u, [&](auto v) { a[v] += c; });
+    }
+    for (int v=0; v<N; v++)
+      a[v] = c0 + p*(a[v] + d);
+    T e = l1Norm(a, r); swap(a, r); ++l;
+    if (e<o.tolerance) break;
+  }
+  return PagerankResult<T>(move(r), l);
+}
+
+
+template <class C, class T=double>
+auto pagerankPushOmp(const C& x, const vector<int>& degs, const PagerankOptions<T>& o=PagerankOptions<T>()) {
+  int N = csrOrder(x), l = 0;
+  T p = o.damping, c0 = (1-p)/N;
+  vector<T> a(N), r(N, T(1)/N);
+  while (l<o.maxIterations) {
+    T d = T();
+    fillOmp(a, T());
+    #pragma omp parallel for schedule(dynamic,2048) reduction(+:d)
+    for (int u=0; u<N; u++) {
+      if (!degs[u]) { d += r[u]/N; continue; }
+      T c = r[u]/degs[u];
+      csrForEachEdge(x, u, [&](auto v) {
+        #pragma omp atomic
+        a[v] += c;
+      });
+    }
+    #pragma omp parallel for schedule(static,2048)
+    for (int v=0; v<N; v++)
+      a[v] = c0 + p*(a[v] + d);
+    T e = l1NormOmp(a, r); swap(a, r); ++l;
+    if (e<o.tolerance) break;
+  }
+  return PagerankResult<T>(move(r), l);
+}
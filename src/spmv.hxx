@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "_main.hxx"
+#include "csr.hxx"
+
+using std::vector;
+
+
+
+
+// SPMV
+// ----
+// Multiply adjacency matrix (unit weights) with a dense vector.
+
+template <class C, class T>
+void spmv(vector<T>& a, const C& x, const vector<T>& r) {
+  for (int u=0, N=csrOrder(x); u<N; u++) {
+    T s = T();
+    csrForEachEdge(x, u, [&](auto v) { s += r[v]; });
+    a[u] = s;
+  }
+}
+
+template <class C, class T>
+auto spmv(const C& x, const vector<T>& r) {
+  vector<T> a(csrOrder(x)); spmv(a, x, r);
+  return a;
+}
+
+
+template <class C, class T>
+void spmvOmp(vector<T>& a, const C& x, const vector<T>& r) {
+  int N = csrOrder(x);
+  #pragma omp parallel for schedule(dynamic,2048)
+  for (int u=0; u<N; u++) {
+    T s = T();
+    csrForEachEdge(x, u, [&](auto v) { s += r[v]; });
+    a[u] = s;
+  }
+}
+
+template <class C, class T>
+auto spmvOmp(const C& x, const vector<T>& r) {
+  vector<T> a(csrOrder(x)); spmvOmp(a, x, r);
+  return a;
+}